@@ -1,6 +1,8 @@
 C:\VulkanSDK\1.3.236.0\Bin\glslc.exe shader.vert -o vert.spv
+C:\VulkanSDK\1.3.236.0\Bin\glslc.exe shader_packed.vert -o vertPacked.spv
 C:\VulkanSDK\1.3.236.0\Bin\glslc.exe shader.frag -o frag.spv
 C:\VulkanSDK\1.3.236.0\Bin\glslc.exe shader.geom -o geom.spv
+C:\VulkanSDK\1.3.236.0\Bin\glslc.exe cull.comp -o cull.spv
 
 C:\VulkanSDK\1.3.236.0\Bin\glslc.exe Line.vert -o LineV.spv
 C:\VulkanSDK\1.3.236.0\Bin\glslc.exe Line.frag -o LineF.spv
@@ -0,0 +1,28 @@
+#version 450
+
+layout(binding = 0) uniform UniformBufferObject {
+    mat4 model;
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+// positions are unorm16 inside the mesh bounds, the model matrix carries the dequantization
+layout(location = 0) in vec4 inPosition;
+layout(location = 2) in vec2 inTexCoord;
+layout(location = 3) in vec2 inNormal;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+
+vec3 decodeOctahedral(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+
+void main() {
+    gl_Position = ubo.proj * ubo.view * ubo.model * vec4(inPosition.xyz, 1.0);
+    fragColor = decodeOctahedral(inNormal) * 0.5 + 0.5;
+    fragTexCoord = inTexCoord;
+}
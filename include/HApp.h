@@ -11,6 +11,10 @@
 #include "vulkan/HRenderer.h"
 #include "vulkan/RenderSystem.h"
 #include "vulkan/CanvasSystem.h"
+#include "vulkan/HGeometryArena.h"
+#include "vulkan/HTextureStreamer.h"
+#include "vulkan/HMemoryMonitor.h"
+#include "vulkan/HPerfOverlay.h"
 #include "HCamera.h"
 #include <tracy/Tracy.hpp>
 
@@ -25,6 +29,8 @@ namespace Hellion
             canvas.line({0.f, 0.f, 0.f}, {10.f, 10.f, 0.f}, {0, 0, 255, 255});
             canvas.plane3d({0,1.5,0}, {0,1,0}, {1,0,0}, 40, 40, 10.0f, 10.0f, {1,0,0,1}, {0,255,0,1});
             canvas.init(renderer.getSwapChainRenderPass(), *renderer.getSwapChain());
+            memory.addPressureCallback([this](uint32_t heap, vk::DeviceSize excess)
+                                       { textures.evict(excess); });
         }
 
         ~HApp()
@@ -37,29 +43,61 @@ namespace Hellion
             {
                 HELLION_ZONE_PROFILING()
                 glfwPollEvents();
+                renderer.getFramePacer().markInputSampled();
+                renderer.applyPendingSettings();
                 renderer.getImGuiRender().NewFrame();
+                renderer.drawFramePacingUi();
+                textures.drawStatsUi();
+                memory.drawUi();
+                perf.drawUi();
 
                 camera.update(window.getWindow());
 
                 if(auto commandBuffer = renderer.beginFrame())
                 {
                     int frameIndex = renderer.getFrameIndex();
+                    memory.update();
+                    auto& frameArena = renderer.getFrameArena();
+                    textures.update(frameArena);
+                    device.getDefragmenter().update();
+                    geometry.update();
 
                     renderer.getImGuiRender().render();
-                    renderer.beginSwapChainRenderPass(commandBuffer);
 
                     auto exte = renderer.getSwapChain()->getSwapChainExtent();
-                    renderSystem.updateBuffers(renderer.getFrameIndex(), exte.width, exte.height, camera);
-                    renderSystem.draw(commandBuffer, renderer.getFrameIndex(), renderer.getCurrentTracyCtx());
+                    renderSystem.updateBuffers(renderer.getFrameIndex(), exte.width, exte.height, camera, frameArena);
+
+                    auto computeBuffer = renderer.beginCompute();
+                    renderSystem.cull(computeBuffer, renderer.getFrameIndex(), renderer.getCurrentComputeTracyCtx());
+                    renderer.endCompute();
+
+                    renderer.beginSwapChainRenderPass(commandBuffer);
+                    {
+                        HGpuPassScope pass{renderer.getGpuQueries(), commandBuffer, "RenderSystem"};
+                        renderSystem.draw(commandBuffer, renderer.getFrameIndex(), renderer.getCurrentTracyCtx());
+                    }
 
                     canvas.updateBuffers(renderer.getFrameIndex(), exte.width, exte.height, camera);
-                    canvas.draw(commandBuffer, renderer.getFrameIndex(), renderer.getCurrentTracyCtx());
+                    {
+                        HGpuPassScope pass{renderer.getGpuQueries(), commandBuffer, "CanvasSystem"};
+                        canvas.draw(commandBuffer, renderer.getFrameIndex(), renderer.getCurrentTracyCtx());
+                    }
 
                     renderer.endSwapChainRenderPass(commandBuffer);
                     renderer.endFrame();
                 }
             }
             device.getDevice().waitIdle();
+            renderer.getFramePacer().report();
+            device.printAllocationStats();
+            HAllocationTracker::report();
+            renderer.getGpuQueries().report();
+            perf.report();
+            if(HProfiler::enabled())
+            {
+                HProfiler::global().dumpCsv("profile.csv");
+                HProfiler::global().dumpJson("profile.json");
+            }
         }
 
         static constexpr int WIDTH = 800;
@@ -70,7 +108,11 @@ namespace Hellion
         HWindow window{WIDTH, HEIGHT, "Hello Vulkan!"};
         HDevice device{window};
         HRenderer renderer{window, device};
-        RenderSystem renderSystem{device, renderer.getSwapChainRenderPass(), *renderer.getSwapChain()};
+        HGeometryArena geometry{device};
+        HTextureStreamer textures{device};
+        HMemoryMonitor memory{device};
+        HPerfOverlay perf{renderer.getGpuQueries()};
+        RenderSystem renderSystem{device, geometry, textures, renderer.getSwapChainRenderPass(), *renderer.getSwapChain()};
         CanvasSystem canvas{device};
         //HSwapChain swapChain{window, device};
 
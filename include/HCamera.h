@@ -34,6 +34,13 @@ namespace Hellion
             return glm::perspective(glm::radians(fov), (float) size.x / (float) size.y, 0.1f, 100.0f);
         }
 
+        glm::vec3 getPosition() const
+        { return cameraPos; }
+
+        /// vertical field of view in degrees
+        float getFov() const
+        { return fov; }
+
         void update(GLFWwindow* window)
         {
             if(glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
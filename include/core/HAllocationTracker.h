@@ -0,0 +1,103 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HALLOCATIONTRACKER_H
+#define HELLION_HALLOCATIONTRACKER_H
+
+#include <atomic>
+#include <cstdint>
+#include <vk_mem_alloc.h>
+
+namespace Hellion
+{
+    struct HAllocationCounts
+    {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        /// vkAllocateMemory calls made by VMA
+        uint64_t deviceAllocations = 0;
+        uint64_t deviceBytes = 0;
+    };
+
+    /// Totals of one HELLION_ALLOCATION_SCOPE site, allocations are attributed to the innermost scope of the calling thread.
+    struct HAllocationScopeStats
+    {
+        HAllocationScopeStats(const char* name, bool forbidden);
+
+        const char* name;
+        /// the scope is a hot path that must not allocate, allocations in it are reported at the end of the frame
+        bool forbidden;
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> bytes{0};
+        uint64_t frameStartAllocations = 0;
+        uint64_t lastFrameAllocations = 0;
+        bool warned = false;
+        HAllocationScopeStats* next = nullptr;
+    };
+
+    class HAllocationScope
+    {
+    public:
+        explicit HAllocationScope(HAllocationScopeStats& stats);
+
+        ~HAllocationScope();
+
+        HAllocationScope(const HAllocationScope&) = delete;
+
+        HAllocationScope& operator=(const HAllocationScope&) = delete;
+
+    private:
+        HAllocationScopeStats* previous;
+    };
+
+    /// Hooks the global operator new/delete and VMA's device memory callbacks. The hooks are only compiled in with the
+    /// HELLION_TRACK_ALLOCATIONS option, without it every count is 0. With HELLION_PROFILING the allocations also go to
+    /// Tracy's memory profiler, which attributes them to the enclosing zones.
+    class HAllocationTracker
+    {
+    public:
+        static constexpr bool enabled()
+        {
+#ifdef HELLION_TRACK_ALLOCATIONS
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /// heap allocations since startup, from any thread
+        static uint64_t allocations();
+
+        /// Closes the current frame: computes its counts, plots them to Tracy and reports allocations in forbidden scopes.
+        static void endFrame();
+
+        static const HAllocationCounts& getLastFrame();
+
+        /// largest per frame values seen so far
+        static const HAllocationCounts& getPeakFrame();
+
+        /// Averages, peaks and the busiest scopes, printed on exit next to the other statistics.
+        static void report();
+
+        /// For VmaAllocatorCreateInfo::pDeviceMemoryCallbacks, nullptr when tracking is off.
+        static const VmaDeviceMemoryCallbacks* deviceMemoryCallbacks();
+    };
+
+} // Hellion
+
+#ifdef HELLION_TRACK_ALLOCATIONS
+#define HELLION_ALLOCATION_SCOPE_CONCAT_(a, b) a##b
+#define HELLION_ALLOCATION_SCOPE_CONCAT(a, b) HELLION_ALLOCATION_SCOPE_CONCAT_(a, b)
+#define HELLION_ALLOCATION_SCOPE_IMPL(name, forbidden) \
+    static Hellion::HAllocationScopeStats HELLION_ALLOCATION_SCOPE_CONCAT(hellionAllocationStats, __LINE__){name, forbidden}; \
+    Hellion::HAllocationScope HELLION_ALLOCATION_SCOPE_CONCAT(hellionAllocationScope, __LINE__){HELLION_ALLOCATION_SCOPE_CONCAT(hellionAllocationStats, __LINE__)};
+#define HELLION_ALLOCATION_SCOPE(name) HELLION_ALLOCATION_SCOPE_IMPL(name, false)
+/// hot paths that are held to zero allocations
+#define HELLION_NO_ALLOCATION_SCOPE(name) HELLION_ALLOCATION_SCOPE_IMPL(name, true)
+#else
+#define HELLION_ALLOCATION_SCOPE(name)
+#define HELLION_NO_ALLOCATION_SCOPE(name)
+#endif
+
+#endif //HELLION_HALLOCATIONTRACKER_H
@@ -0,0 +1,74 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HFRAMEARENA_H
+#define HELLION_HFRAMEARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace Hellion
+{
+    /// Bump allocator for data that only lives until its frame slot comes around again, e.g. std::pmr::vector<vk::WriteDescriptorSet>.
+    /// Deallocation does nothing, reset releases everything at once. Not thread safe, one arena per frame in flight.
+    class HFrameArena : public std::pmr::memory_resource
+    {
+    public:
+        static constexpr size_t DEFAULT_CAPACITY = 256 * 1024;
+
+        explicit HFrameArena(size_t capacity = DEFAULT_CAPACITY);
+
+        HFrameArena(const HFrameArena&) = delete;
+
+        HFrameArena& operator=(const HFrameArena&) = delete;
+
+        /// Starts over at the beginning of the buffer. When the last use overflowed into the heap, the buffer grows to the
+        /// peak so the following frames fit again.
+        void reset();
+
+        size_t getUsed() const
+        { return used; }
+
+        size_t getCapacity() const
+        { return capacity; }
+
+        /// largest use of a frame since construction, overflow included
+        size_t getPeak() const
+        { return peak; }
+
+        /// allocations that did not fit into the buffer and went to the heap
+        size_t getOverflowCount() const
+        { return overflowCount; }
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {}
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        { return this == &other; }
+
+        struct Overflow
+        {
+            void* pointer;
+            size_t bytes;
+            size_t alignment;
+        };
+
+        std::unique_ptr<std::byte[]> buffer;
+        size_t capacity;
+        size_t offset = 0;
+        /// bytes handed out this frame, overflow included
+        size_t used = 0;
+        size_t peak = 0;
+        size_t overflowCount = 0;
+        std::vector<Overflow> overflow;
+    };
+
+} // Hellion
+
+#endif //HELLION_HFRAMEARENA_H
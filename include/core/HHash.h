@@ -0,0 +1,41 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HHASH_H
+#define HELLION_HHASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace Hellion
+{
+    inline uint64_t fnv1a(const void* data, size_t size, uint64_t hash = 0xcbf29ce484222325ull)
+    {
+        auto bytes = static_cast<const uint8_t*>(data);
+        for(size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    /// Identifies a file by path, size and modification time without reading it, used to validate derived cache files.
+    inline uint64_t hashFileIdentity(const std::string& path, uint64_t hash = 0xcbf29ce484222325ull)
+    {
+        std::error_code ec;
+        auto size = static_cast<uint64_t>(std::filesystem::file_size(path, ec));
+        auto time = static_cast<int64_t>(std::filesystem::last_write_time(path, ec).time_since_epoch().count());
+
+        hash = fnv1a(path.data(), path.size(), hash);
+        hash = fnv1a(&size, sizeof(size), hash);
+        hash = fnv1a(&time, sizeof(time), hash);
+        return hash;
+    }
+
+} // Hellion
+
+#endif //HELLION_HHASH_H
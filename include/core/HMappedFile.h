@@ -0,0 +1,64 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HMAPPEDFILE_H
+#define HELLION_HMAPPEDFILE_H
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+namespace Hellion
+{
+    /// Read-only memory mapping of a whole file.
+    class HMappedFile
+    {
+    public:
+        HMappedFile() = default;
+
+        explicit HMappedFile(const std::string& path)
+        { open(path); }
+
+        ~HMappedFile()
+        { close(); }
+
+        HMappedFile(const HMappedFile&) = delete;
+
+        HMappedFile& operator=(const HMappedFile&) = delete;
+
+        HMappedFile(HMappedFile&& other) noexcept
+        { *this = std::move(other); }
+
+        HMappedFile& operator=(HMappedFile&& other) noexcept;
+
+        /// Returns false if the file does not exist or can not be mapped.
+        bool open(const std::string& path);
+
+        void close();
+
+        bool isOpen() const
+        { return data != nullptr; }
+
+        std::span<const std::byte> bytes() const
+        { return {static_cast<const std::byte*>(data), size}; }
+
+        size_t getSize() const
+        { return size; }
+
+    private:
+        const void* data = nullptr;
+        size_t size = 0;
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#endif
+    };
+
+    /// Writes the file under a temporary name and renames it into place, so a crash never leaves a truncated file behind.
+    /// Returns false when it could not be written.
+    bool writeFileAtomically(const std::string& path, std::span<const std::byte> bytes);
+
+} // Hellion
+
+#endif //HELLION_HMAPPEDFILE_H
@@ -0,0 +1,152 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HPROFILER_H
+#define HELLION_HPROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Hellion
+{
+    /// Totals of one profiling scope, times are inclusive of nested scopes.
+    struct HScopeStats
+    {
+        const char* name = nullptr;
+        double lastMs = 0.0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+        uint64_t calls = 0;
+        /// frames the scope ran in
+        uint64_t frames = 0;
+
+        double averageMs() const
+        { return frames > 0 ? totalMs / static_cast<double>(frames) : 0.0; }
+    };
+
+    struct HFrameTiming
+    {
+        uint64_t frame = UINT64_MAX;
+        /// time between two endFrame calls
+        double cpuMs = 0.0;
+        /// graphics queue time of the frame's command buffer, negative until the timestamps were read back
+        double gpuMs = -1.0;
+    };
+
+    /// Release build profiling without Tracy. Scopes from any thread are written into a lock-free ring, endFrame drains it
+    /// once per frame on the render thread into per scope statistics and a history of frame times. A writer never overwrites
+    /// a slot that was not drained yet, when the ring is full its sample is dropped.
+    class HProfiler
+    {
+    public:
+        static constexpr size_t RING_SIZE = 1 << 14;
+        static constexpr size_t HISTORY_SIZE = 1024;
+
+        static HProfiler& global();
+
+        static constexpr bool enabled()
+        {
+#ifdef HELLION_LIGHT_PROFILING
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        static uint64_t now()
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        /// Lock-free, name must outlive the profiler, e.g. a string literal. Dropped when the ring is full.
+        void record(const char* name, uint64_t startNs, uint64_t endNs);
+
+        /// Render thread only, once per frame.
+        void endFrame();
+
+        /// GPU results arrive a few frames late, they are matched to the frame they were recorded in.
+        void recordGpuFrame(uint64_t frame, double milliseconds);
+
+        /// the frame endFrame will close next
+        uint64_t getFrame() const
+        { return frame; }
+
+        const std::vector<HScopeStats>& getScopes() const
+        { return scopes; }
+
+        const std::array<HFrameTiming, HISTORY_SIZE>& getHistory() const
+        { return history; }
+
+        /// samples lost because the ring was full
+        uint64_t getDropped() const
+        { return dropped.load(std::memory_order_relaxed); }
+
+        /// One row per frame of the history: frame, cpu_ms, gpu_ms.
+        void dumpCsv(const std::string& path) const;
+
+        /// The history and the scope statistics.
+        void dumpJson(const std::string& path) const;
+
+    private:
+        HProfiler();
+
+        struct Sample
+        {
+            const char* name;
+            uint64_t startNs;
+            uint64_t endNs;
+        };
+
+        struct Slot
+        {
+            /// index + 1 once the sample is written
+            std::atomic<uint64_t> sequence{0};
+            Sample sample;
+        };
+
+        std::unique_ptr<Slot[]> ring;
+        std::atomic<uint64_t> writeIndex{0};
+        /// written by endFrame after the samples before it were copied, writers claim a slot only while it is RING_SIZE ahead
+        std::atomic<uint64_t> readIndex{0};
+        std::atomic<uint64_t> dropped{0};
+
+        std::vector<HScopeStats> scopes;
+        std::unordered_map<const char*, size_t> scopeIndices;
+        /// nanoseconds of each scope in the current frame
+        std::vector<uint64_t> frameNs;
+        std::vector<uint32_t> frameCalls;
+
+        std::array<HFrameTiming, HISTORY_SIZE> history{};
+        uint64_t frame = 0;
+        uint64_t frameStartNs = 0;
+    };
+
+    class HProfileScope
+    {
+    public:
+        explicit HProfileScope(const char* name) : name{name}, start{HProfiler::now()}
+        {}
+
+        ~HProfileScope()
+        { HProfiler::global().record(name, start, HProfiler::now()); }
+
+        HProfileScope(const HProfileScope&) = delete;
+
+        HProfileScope& operator=(const HProfileScope&) = delete;
+
+    private:
+        const char* name;
+        uint64_t start;
+    };
+
+} // Hellion
+
+#endif //HELLION_HPROFILER_H
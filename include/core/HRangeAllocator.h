@@ -0,0 +1,56 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HRANGEALLOCATOR_H
+#define HELLION_HRANGEALLOCATOR_H
+
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace Hellion
+{
+    /// Best-fit free-list suballocator over an abstract [0, capacity) range, adjacent free blocks are coalesced on free.
+    /// Holds no memory itself, offsets and sizes are in whatever unit the caller uses.
+    class HRangeAllocator
+    {
+    public:
+        explicit HRangeAllocator(uint64_t capacity = 0)
+        { reset(capacity); }
+
+        /// Alignment may be any non-zero value, vertex ranges are aligned to their stride which is not a power of two.
+        std::optional<uint64_t> allocate(uint64_t size, uint64_t alignment = 1);
+
+        void free(uint64_t offset, uint64_t size);
+
+        void reset(uint64_t capacity);
+
+        uint64_t getCapacity() const
+        { return capacity; }
+
+        uint64_t getFreeSpace() const
+        { return freeSpace; }
+
+        uint64_t getLargestFreeBlock() const
+        { return bySize.empty() ? 0 : bySize.rbegin()->first; }
+
+        size_t getFreeBlockCount() const
+        { return byOffset.size(); }
+
+    private:
+        void insertFree(uint64_t offset, uint64_t size);
+
+        void eraseFree(std::map<uint64_t, uint64_t>::iterator block);
+
+        uint64_t capacity = 0;
+        uint64_t freeSpace = 0;
+        /// offset -> size, for coalescing
+        std::map<uint64_t, uint64_t> byOffset;
+        /// size -> offset, for the best-fit search
+        std::multimap<uint64_t, uint64_t> bySize;
+    };
+
+} // Hellion
+
+#endif //HELLION_HRANGEALLOCATOR_H
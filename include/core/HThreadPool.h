@@ -0,0 +1,73 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HTHREADPOOL_H
+#define HELLION_HTHREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Hellion
+{
+    class HThreadPool
+    {
+    public:
+        explicit HThreadPool(size_t threadCount = defaultThreadCount());
+
+        ~HThreadPool();
+
+        HThreadPool(const HThreadPool&) = delete;
+
+        HThreadPool& operator=(const HThreadPool&) = delete;
+
+        template<class F>
+        auto submit(F&& task) -> std::future<std::invoke_result_t<F>>
+        {
+            using R = std::invoke_result_t<F>;
+            auto packaged = std::make_shared<std::packaged_task<R()>>(std::forward<F>(task));
+            auto future = packaged->get_future();
+            {
+                std::lock_guard lock(mutex);
+                tasks.emplace_back([packaged]()
+                                   { (*packaged)(); });
+            }
+            condition.notify_one();
+            return future;
+        }
+
+        /// Splits [0, count) into ranges of at most grain elements and blocks until all of them ran.
+        /// The calling thread works on ranges too, so nested calls from a worker can not deadlock.
+        void parallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)>& body);
+
+        size_t getThreadCount() const
+        { return workers.size(); }
+
+        static HThreadPool& global();
+
+        static size_t defaultThreadCount()
+        {
+            auto hw = std::thread::hardware_concurrency();
+            return hw > 1 ? hw - 1 : 1;
+        }
+
+    private:
+        void workerLoop();
+
+        bool runPendingTask();
+
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool stopping = false;
+    };
+
+} // Hellion
+
+#endif //HELLION_HTHREADPOOL_H
@@ -8,19 +8,28 @@
 #include <vulkan/vulkan.hpp>
 #include <tracy/Tracy.hpp>
 #include <tracy/TracyVulkan.hpp>
+#include "HProfiler.h"
 
 namespace Hellion
 {
-#ifdef HELLION_PROFILING
 #ifdef __GNUC__
-#define HELLION_ZONE_PROFILING() ZoneScopedN(__PRETTY_FUNCTION__);
+#define HELLION_FUNCTION_NAME __PRETTY_FUNCTION__
+#else
+#define HELLION_FUNCTION_NAME __FUNCSIG__
+#endif
+
+// the light profiler runs in every configuration it is compiled into, Tracy only with HELLION_PROFILING
+#ifdef HELLION_LIGHT_PROFILING
+#define HELLION_LIGHT_SCOPE(name) Hellion::HProfileScope hellionProfileScope{name};
 #else
-#define HELLION_ZONE_PROFILING() ZoneScopedN(__FUNCSIG__);
+#define HELLION_LIGHT_SCOPE(name)
 #endif
+
+#ifdef HELLION_PROFILING
+#define HELLION_ZONE_PROFILING() ZoneScopedN(HELLION_FUNCTION_NAME); HELLION_LIGHT_SCOPE(HELLION_FUNCTION_NAME)
 #define HELLION_GPUZONE_PROFILING(ctx, buf, name) TracyVkZone(ctx,buf,name)
 #else
-#define HELLION_ZONE_PROFILING()
-#define HELLION_ZONE_PROFILING(name)
+#define HELLION_ZONE_PROFILING() HELLION_LIGHT_SCOPE(HELLION_FUNCTION_NAME)
 #define HELLION_GPUZONE_PROFILING(ctx, buf, name)
 #endif
 
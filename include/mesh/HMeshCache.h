@@ -0,0 +1,124 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HMESHCACHE_H
+#define HELLION_HMESHCACHE_H
+
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+#include "HMeshData.h"
+#include "HVertexEncoding.h"
+#include "../core/HMappedFile.h"
+
+namespace Hellion
+{
+    struct HMeshHeader
+    {
+        static constexpr uint32_t MAGIC = 0x48534D48; // "HMSH"
+        static constexpr uint32_t VERSION = 6;
+
+        uint32_t magic;
+        uint32_t version;
+        uint64_t sourceHash;
+        uint32_t vertexStride;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        HVertexFormat vertexFormat;
+        float boundsMin[3];
+        float boundsMax[3];
+        float quantizationOffset[3];
+        float quantizationScale[3];
+        uint32_t lodCount;
+        uint32_t meshletCount;
+        uint64_t vertexOffset;
+        uint64_t indexOffset;
+        uint64_t lodOffset;
+        uint64_t meshletOffset;
+    };
+
+    /// Compiled mesh that lives in a memory-mapped cache file, the spans point straight into the mapping.
+    /// When the cache could not be written the same layout is kept in a heap buffer instead.
+    class HMappedMesh
+    {
+    public:
+        HMappedMesh(HMappedFile&& file) : file{std::move(file)}
+        {}
+
+        HMappedMesh(std::vector<std::byte>&& buffer) : buffer{std::move(buffer)}
+        {}
+
+        std::span<const std::byte> bytes() const
+        { return buffer.empty() ? file.bytes() : std::span<const std::byte>(buffer); }
+
+        const HMeshHeader& header() const
+        { return *reinterpret_cast<const HMeshHeader*>(bytes().data()); }
+
+        std::span<const std::byte> vertexBytes() const
+        { return bytes().subspan(header().vertexOffset, static_cast<size_t>(header().vertexCount) * header().vertexStride); }
+
+        std::span<const uint32_t> indices() const
+        {
+            auto data = bytes().subspan(header().indexOffset, static_cast<size_t>(header().indexCount) * sizeof(uint32_t));
+            return {reinterpret_cast<const uint32_t*>(data.data()), header().indexCount};
+        }
+
+        std::span<const HMeshLod> lods() const
+        {
+            auto data = bytes().subspan(header().lodOffset, static_cast<size_t>(header().lodCount) * sizeof(HMeshLod));
+            return {reinterpret_cast<const HMeshLod*>(data.data()), header().lodCount};
+        }
+
+        std::span<const HMeshlet> meshlets() const
+        {
+            auto data = bytes().subspan(header().meshletOffset, static_cast<size_t>(header().meshletCount) * sizeof(HMeshlet));
+            return {reinterpret_cast<const HMeshlet*>(data.data()), header().meshletCount};
+        }
+
+        HBounds bounds() const
+        {
+            auto& h = header();
+            return {{h.boundsMin[0], h.boundsMin[1], h.boundsMin[2]}, {h.boundsMax[0], h.boundsMax[1], h.boundsMax[2]}};
+        }
+
+        HVertexFormat vertexFormat() const
+        { return header().vertexFormat; }
+
+        HQuantization quantization() const
+        {
+            auto& h = header();
+            return {{h.quantizationOffset[0], h.quantizationOffset[1], h.quantizationOffset[2]},
+                    {h.quantizationScale[0],  h.quantizationScale[1],  h.quantizationScale[2]}};
+        }
+
+    private:
+        HMappedFile file;
+        std::vector<std::byte> buffer;
+    };
+
+    class HMeshCache
+    {
+    public:
+        /// Maps the cache file next to sourcePath, importing and writing it first when it is missing or stale.
+        static HMappedMesh loadOrImport(const std::string& sourcePath, const std::function<HMeshData(const std::string&)>& importer,
+                                        HVertexFormat format = HVertexFormat::Full);
+
+        /// Identifies the source by path, size and modification time, so the source does not have to be read to validate the cache.
+        static uint64_t hashSource(const std::string& sourcePath);
+
+        static std::optional<HMappedMesh> load(const std::string& cachePath, uint64_t sourceHash, HVertexFormat format);
+
+        /// The cache file contents: header, vertices, indices, LODs and meshlets. format goes through HVertexEncoding::resolve,
+        /// the header records the one that was used.
+        static std::vector<std::byte> serialize(const HMeshData& mesh, uint64_t sourceHash, HVertexFormat format);
+
+        /// Every vertex format gets its own cache file so meshes with different layouts can share a source.
+        static std::string cachePathFor(const std::string& sourcePath, HVertexFormat format)
+        { return sourcePath + "." + std::to_string(static_cast<uint32_t>(format)) + ".hmesh"; }
+    };
+
+} // Hellion
+
+#endif //HELLION_HMESHCACHE_H
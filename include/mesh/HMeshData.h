@@ -0,0 +1,87 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HMESHDATA_H
+#define HELLION_HMESHDATA_H
+
+#include <vector>
+#include <glm/glm.hpp>
+#include "../vulkan/HVertex.h"
+#include "HMeshlet.h"
+
+namespace Hellion
+{
+    struct HBounds
+    {
+        glm::vec3 min{0.0f};
+        glm::vec3 max{0.0f};
+
+        glm::vec3 center() const
+        { return (min + max) * 0.5f; }
+
+        float radius() const
+        { return glm::length(max - min) * 0.5f; }
+    };
+
+    /// Range of the shared index buffer drawn for one level of detail.
+    struct HMeshLod
+    {
+        uint32_t indexOffset = 0;
+        uint32_t indexCount = 0;
+        /// simplification error in mesh units, 0 for the full detail level
+        float error = 0.0f;
+    };
+
+    /// CPU side mesh as produced by the importers.
+    struct HMeshData
+    {
+        std::vector<HVertex> vertices;
+        /// all LODs back to back, LOD 0 first
+        std::vector<uint32_t> indices;
+        /// empty until the LOD chain is generated, a mesh without LODs is drawn as a whole
+        std::vector<HMeshLod> lods;
+        /// clusters of the LOD 0 range for GPU culling
+        std::vector<HMeshlet> meshlets;
+        /// smooth normals of the welded vertices, only filled by computeNormals
+        std::vector<glm::vec3> normals;
+        HBounds bounds;
+
+        void computeBounds()
+        {
+            if(vertices.empty())
+            {
+                bounds = {};
+                return;
+            }
+            bounds.min = bounds.max = vertices[0].pos;
+            for(const auto& vertex: vertices)
+            {
+                bounds.min = glm::min(bounds.min, vertex.pos);
+                bounds.max = glm::max(bounds.max, vertex.pos);
+            }
+        }
+
+        void computeNormals()
+        {
+            normals.assign(vertices.size(), glm::vec3(0.0f));
+            // coarser LODs reuse the same vertices, only the full detail faces contribute
+            size_t indexCount = lods.empty() ? indices.size() : lods[0].indexCount;
+            for(size_t i = 0; i + 2 < indexCount; i += 3)
+            {
+                uint32_t a = indices[i], b = indices[i + 1], c = indices[i + 2];
+                // the cross product is area weighted, large faces dominate the vertex normal
+                glm::vec3 n = glm::cross(vertices[b].pos - vertices[a].pos, vertices[c].pos - vertices[a].pos);
+                normals[a] += n;
+                normals[b] += n;
+                normals[c] += n;
+            }
+            for(auto& n: normals)
+                if(glm::length(n) > 0.0f)
+                    n = glm::normalize(n);
+        }
+    };
+
+} // Hellion
+
+#endif //HELLION_HMESHDATA_H
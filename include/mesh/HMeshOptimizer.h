@@ -0,0 +1,55 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HMESHOPTIMIZER_H
+#define HELLION_HMESHOPTIMIZER_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Hellion
+{
+    struct HVertexCacheStats
+    {
+        /// average cache miss ratio, transformed vertices per triangle (0.5 is the ideal for large regular meshes, 3 the worst)
+        float acmr = 0.0f;
+        /// average transform to vertex ratio, transformed vertices per unique vertex (1 is ideal)
+        float atvr = 0.0f;
+    };
+
+    /// Index buffer optimizations run at import time, positions are read from a strided float array.
+    class HMeshOptimizer
+    {
+    public:
+        static constexpr uint32_t SIMULATED_CACHE_SIZE = 16;
+
+        /// Reorders triangles for post-transform cache locality (Forsyth, "Linear-Speed Vertex Cache Optimisation").
+        static void optimizeVertexCache(std::span<uint32_t> indices, size_t vertexCount);
+
+        /// Reorders clusters of the cache optimized triangle list so outward facing clusters come first, which reduces overdraw.
+        /// The new order is dropped when it makes the ACMR worse than threshold times the input.
+        static void optimizeOverdraw(std::span<uint32_t> indices, const float* positions, size_t vertexCount, size_t positionStride,
+                                     float threshold = 1.05f);
+
+        /// Renumbers vertices in the order the index buffer first references them and rewrites the indices.
+        /// Returns the old to new vertex remap, unreferenced vertices are moved to the end.
+        static std::vector<uint32_t> optimizeVertexFetch(std::span<uint32_t> indices, size_t vertexCount);
+
+        template<class Vertex>
+        static void remapVertices(std::vector<Vertex>& vertices, const std::vector<uint32_t>& remap)
+        {
+            std::vector<Vertex> result(vertices.size());
+            for(size_t i = 0; i < vertices.size(); i++)
+                result[remap[i]] = vertices[i];
+            vertices = std::move(result);
+        }
+
+        static HVertexCacheStats analyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount,
+                                                    uint32_t cacheSize = SIMULATED_CACHE_SIZE);
+    };
+
+} // Hellion
+
+#endif //HELLION_HMESHOPTIMIZER_H
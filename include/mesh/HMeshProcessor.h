@@ -0,0 +1,35 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HMESHPROCESSOR_H
+#define HELLION_HMESHPROCESSOR_H
+
+#include "HMeshData.h"
+
+namespace Hellion
+{
+    /// Import-time processing applied to a mesh before it is written to the mesh cache.
+    class HMeshProcessor
+    {
+    public:
+        static void process(HMeshData& mesh);
+
+        static constexpr uint32_t MAX_LODS = 8;
+        /// the chain stops before a LOD would drop below this many triangles
+        static constexpr uint32_t MIN_LOD_TRIANGLES = 64;
+        /// every LOD targets this fraction of the previous LOD's triangles
+        static constexpr float LOD_REDUCTION = 0.5f;
+
+        static void optimize(HMeshData& mesh);
+
+        /// Splits the LOD 0 range into meshlets, must run after every pass that reorders the LOD 0 triangles.
+        static void buildMeshlets(HMeshData& mesh);
+
+        /// Appends a chain of simplified index ranges to mesh.indices, all of them referencing the LOD 0 vertices.
+        static void generateLods(HMeshData& mesh);
+    };
+
+} // Hellion
+
+#endif //HELLION_HMESHPROCESSOR_H
@@ -0,0 +1,35 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HMESHSIMPLIFIER_H
+#define HELLION_HMESHSIMPLIFIER_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Hellion
+{
+    struct HSimplifiedMesh
+    {
+        std::vector<uint32_t> indices;
+        /// largest RMS distance of a collapsed vertex to the planes of the source faces it absorbed, in mesh units
+        float error = 0.0f;
+    };
+
+    /// Quadric error metric edge-collapse simplifier (Garland, Heckbert, "Surface Simplification Using Quadric Error Metrics").
+    /// Vertices are collapsed onto existing vertices, so the vertex buffer is shared by every LOD and only a new index buffer is produced.
+    /// UV seams and open borders only collapse along themselves, non-manifold vertices are locked.
+    class HMeshSimplifier
+    {
+    public:
+        static constexpr float BORDER_WEIGHT = 4.0f;
+
+        static HSimplifiedMesh simplify(std::span<const uint32_t> indices, const float* positions, size_t vertexCount, size_t positionStride,
+                                        size_t targetIndexCount, float targetError);
+    };
+
+} // Hellion
+
+#endif //HELLION_HMESHSIMPLIFIER_H
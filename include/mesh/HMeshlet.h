@@ -0,0 +1,47 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HMESHLET_H
+#define HELLION_HMESHLET_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Hellion
+{
+    /// Cluster of consecutive triangles of the LOD 0 index range. The layout matches the Meshlet struct in cull.comp
+    /// and is uploaded straight from the mesh cache.
+    struct HMeshlet
+    {
+        float center[3];
+        float radius;
+        /// triangles face away from the axis by at most acos(sqrt(1 - cutoff^2)), a cutoff of 1 disables cone culling
+        float coneAxis[3];
+        float coneCutoff;
+        uint32_t indexOffset;
+        uint32_t indexCount;
+        uint32_t vertexCount;
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(HMeshlet) == 48, "HMeshlet must match the std430 layout of cull.comp");
+
+    class HMeshletBuilder
+    {
+    public:
+        static constexpr uint32_t MAX_VERTICES = 64;
+        static constexpr uint32_t MAX_TRIANGLES = 124;
+
+        /// Splits the triangle list into consecutive ranges of at most MAX_VERTICES unique vertices and MAX_TRIANGLES triangles.
+        /// The index order is kept, so a meshlet is drawn with a plain indexed draw and the vertex cache order survives.
+        static std::vector<HMeshlet> build(std::span<const uint32_t> indices, const float* positions, size_t vertexCount, size_t positionStride);
+
+        /// Bounding sphere and normal cone of the triangles in meshlet.indexOffset .. indexOffset + indexCount.
+        static void computeBounds(HMeshlet& meshlet, std::span<const uint32_t> indices, const float* positions, size_t positionStride);
+    };
+
+} // Hellion
+
+#endif //HELLION_HMESHLET_H
@@ -0,0 +1,21 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HOBJIMPORTER_H
+#define HELLION_HOBJIMPORTER_H
+
+#include <string>
+#include "HMeshData.h"
+
+namespace Hellion
+{
+    class HObjImporter
+    {
+    public:
+        static HMeshData import(const std::string& path);
+    };
+
+} // Hellion
+
+#endif //HELLION_HOBJIMPORTER_H
@@ -0,0 +1,56 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HVERTEXENCODING_H
+#define HELLION_HVERTEXENCODING_H
+
+#include <cstddef>
+#include <vector>
+#include "HMeshData.h"
+
+namespace Hellion
+{
+    /// Maps quantized unorm16 positions back to object space: pos = offset + unorm * scale.
+    struct HQuantization
+    {
+        glm::vec3 offset{0.0f};
+        glm::vec3 scale{1.0f};
+
+        /// Prepended to the model matrix, so packed vertices need no extra shader uniforms.
+        glm::mat4 matrix() const
+        { return glm::scale(glm::translate(glm::mat4(1.0f), offset), scale); }
+
+        static HQuantization fromBounds(const HBounds& bounds)
+        {
+            HQuantization quantization;
+            quantization.offset = bounds.min;
+            quantization.scale = glm::max(bounds.max - bounds.min, glm::vec3(1e-6f));
+            return quantization;
+        }
+    };
+
+    /// Runtime dispatch over the compile-time vertex layouts in HVertex.h.
+    class HVertexEncoding
+    {
+    public:
+        static uint32_t stride(HVertexFormat format);
+
+        static vk::VertexInputBindingDescription bindingDescription(HVertexFormat format);
+
+        static std::vector<vk::VertexInputAttributeDescription> attributeDescriptions(HVertexFormat format);
+
+        /// The half uv counterpart of a unorm16 uv format, other formats are returned unchanged.
+        static HVertexFormat halfUvFormat(HVertexFormat format);
+
+        /// unorm16 can only hold uvs in [0, 1], a mesh with tiling or offset uvs falls back to halfUvFormat instead of being clamped.
+        static HVertexFormat resolve(const HMeshData& mesh, HVertexFormat format);
+
+        /// Converts the full float vertices to the requested layout, HQuantization is ignored for HVertexFormat::Full.
+        /// Throws for a unorm16 uv format when a uv is outside [0, 1], pass the format through resolve first.
+        static std::vector<std::byte> encode(const HMeshData& mesh, HVertexFormat format, const HQuantization& quantization);
+    };
+
+} // Hellion
+
+#endif //HELLION_HVERTEXENCODING_H
@@ -0,0 +1,92 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HVERTEXWELDER_H
+#define HELLION_HVERTEXWELDER_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace Hellion
+{
+    /// Deduplicates vertices with an open-addressing hash table of indices into the vertex array.
+    /// Vertices are hashed and compared bitwise, so the vertex type must not contain padding.
+    template<class Vertex>
+    class HVertexWelder
+    {
+    public:
+        explicit HVertexWelder(std::vector<Vertex>& vertices, size_t expectedVertices = 0) : vertices{vertices}
+        {
+            size_t capacity = 64;
+            while(capacity < expectedVertices * 2)
+                capacity *= 2;
+            slots.assign(capacity, EMPTY);
+            vertices.reserve(expectedVertices);
+        }
+
+        /// Returns the index of an equal vertex, appending the vertex when it was not seen yet.
+        uint32_t insert(const Vertex& vertex)
+        {
+            if((vertices.size() + 1) * 2 > slots.size())
+                grow();
+
+            size_t mask = slots.size() - 1;
+            size_t slot = hash(vertex) & mask;
+            while(true)
+            {
+                uint32_t index = slots[slot];
+                if(index == EMPTY)
+                {
+                    index = static_cast<uint32_t>(vertices.size());
+                    vertices.push_back(vertex);
+                    slots[slot] = index;
+                    return index;
+                }
+                if(std::memcmp(&vertices[index], &vertex, sizeof(Vertex)) == 0)
+                    return index;
+                slot = (slot + 1) & mask;
+            }
+        }
+
+    private:
+        static constexpr uint32_t EMPTY = ~0u;
+
+        static size_t hash(const Vertex& vertex)
+        {
+            static_assert(sizeof(Vertex) % sizeof(uint32_t) == 0);
+            uint32_t words[sizeof(Vertex) / sizeof(uint32_t)];
+            std::memcpy(words, &vertex, sizeof(Vertex));
+
+            // murmur2 style mixing, one 32 bit word at a time
+            uint64_t h = 0x9e3779b97f4a7c15ull;
+            for(uint32_t word: words)
+            {
+                uint64_t k = word * 0xff51afd7ed558ccdull;
+                k ^= k >> 33;
+                h = (h ^ k) * 0xc4ceb9fe1a85ec53ull;
+            }
+            return static_cast<size_t>(h ^ (h >> 29));
+        }
+
+        void grow()
+        {
+            slots.assign(slots.size() * 2, EMPTY);
+            size_t mask = slots.size() - 1;
+            for(uint32_t index = 0; index < vertices.size(); index++)
+            {
+                size_t slot = hash(vertices[index]) & mask;
+                while(slots[slot] != EMPTY)
+                    slot = (slot + 1) & mask;
+                slots[slot] = index;
+            }
+        }
+
+        std::vector<Vertex>& vertices;
+        std::vector<uint32_t> slots;
+    };
+
+} // Hellion
+
+#endif //HELLION_HVERTEXWELDER_H
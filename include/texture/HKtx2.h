@@ -0,0 +1,66 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HKTX2_H
+#define HELLION_HKTX2_H
+
+#include <vulkan/vulkan.hpp>
+#include <span>
+#include <string>
+#include <vector>
+#include "../core/HMappedFile.h"
+
+namespace Hellion
+{
+    /// Level of a KTX2 file, offset is relative to the start of the file.
+    struct HKtx2Level
+    {
+        uint32_t width;
+        uint32_t height;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    /// Memory-mapped KTX2 container. Only 2D textures without supercompression are accepted,
+    /// the level data is handed to the GPU as stored.
+    class HKtx2Texture
+    {
+    public:
+        /// Throws if the file can not be mapped or uses a feature that is not supported.
+        explicit HKtx2Texture(const std::string& path);
+
+        vk::Format getFormat() const
+        { return format; }
+
+        uint32_t getWidth() const
+        { return width; }
+
+        uint32_t getHeight() const
+        { return height; }
+
+        /// Levels from the largest to the smallest.
+        const std::vector<HKtx2Level>& getLevels() const
+        { return levels; }
+
+        /// The file stores only the base level and expects the rest of the chain to be generated at load.
+        bool needsMipGeneration() const
+        { return generateMips; }
+
+        std::span<const std::byte> bytes() const
+        { return file.bytes(); }
+
+        static bool isKtx2(const std::string& path);
+
+    private:
+        HMappedFile file;
+        vk::Format format = vk::Format::eUndefined;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        bool generateMips = false;
+        std::vector<HKtx2Level> levels;
+    };
+
+} // Hellion
+
+#endif //HELLION_HKTX2_H
@@ -0,0 +1,100 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HTEXTUREATLAS_H
+#define HELLION_HTEXTUREATLAS_H
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include <stb_rect_pack.h>
+
+namespace Hellion
+{
+    struct HAtlasImage
+    {
+        /// RGBA8, tightly packed rows
+        const uint8_t* rgba;
+        uint32_t width;
+        uint32_t height;
+    };
+
+    /// Where an inserted image ended up, the UV rectangle covers exactly the image texels.
+    struct HAtlasRegion
+    {
+        uint32_t page;
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+        uint32_t height;
+        float uvMin[2];
+        float uvMax[2];
+    };
+
+    /// Square RGBA8 page, version changes whenever an insertion writes into it so its texture knows to be recreated.
+    struct HAtlasPage
+    {
+        std::vector<uint8_t> pixels;
+        uint32_t version = 0;
+    };
+
+    /// Packs small images into shared pages with the bundled stb_rect_pack, so they can be drawn with one descriptor set per page.
+    ///
+    /// Every image is surrounded by copies of its edge texels and packed on a grid of 1 << (mipLevels - 1) texels,
+    /// so neither bilinear filtering nor the first mipLevels levels of the page blend neighbouring images.
+    class HTextureAtlas
+    {
+    public:
+        static constexpr uint32_t DEFAULT_PAGE_SIZE = 2048;
+        static constexpr uint32_t DEFAULT_PADDING = 2;
+        static constexpr uint32_t DEFAULT_MIP_LEVELS = 4;
+
+        /// The padding is raised to the grid size when smaller, a level-k texel has to be covered by padding too.
+        explicit HTextureAtlas(uint32_t pageSize = DEFAULT_PAGE_SIZE, uint32_t padding = DEFAULT_PADDING, uint32_t mipLevels = DEFAULT_MIP_LEVELS);
+
+        HTextureAtlas(const HTextureAtlas&) = delete;
+
+        HTextureAtlas& operator=(const HTextureAtlas&) = delete;
+
+        /// Packs into the existing pages first and opens new pages for what does not fit. Returns the regions in input order.
+        /// Throws if an image is larger than a page.
+        std::vector<HAtlasRegion> insert(std::span<const HAtlasImage> images);
+
+        HAtlasRegion insert(const HAtlasImage& image)
+        { return insert(std::span(&image, 1))[0]; }
+
+        const std::vector<HAtlasPage>& getPages() const
+        { return pages; }
+
+        uint32_t getPageSize() const
+        { return pageSize; }
+
+        /// Levels a page texture may have without neighbours bleeding into each other.
+        uint32_t getMipLevels() const
+        { return mipLevels; }
+
+    private:
+        /// stb_rect_pack state of a page, works on grid cells and keeps its skyline between insertions.
+        struct Packer
+        {
+            std::unique_ptr<stbrp_context> context;
+            std::vector<stbrp_node> nodes;
+        };
+
+        void addPage();
+
+        void blit(uint32_t page, uint32_t x, uint32_t y, const HAtlasImage& image);
+
+        uint32_t pageSize;
+        uint32_t padding;
+        uint32_t mipLevels;
+        uint32_t cellSize;
+        std::vector<HAtlasPage> pages;
+        std::vector<Packer> packers;
+    };
+
+} // Hellion
+
+#endif //HELLION_HTEXTUREATLAS_H
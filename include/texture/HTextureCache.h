@@ -0,0 +1,83 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HTEXTURECACHE_H
+#define HELLION_HTEXTURECACHE_H
+
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+#include "HTextureCompressor.h"
+#include "../core/HMappedFile.h"
+
+namespace Hellion
+{
+    struct HTextureHeader
+    {
+        static constexpr uint32_t MAGIC = 0x58455448; // "HTEX"
+        static constexpr uint32_t VERSION = 1;
+
+        uint32_t magic;
+        uint32_t version;
+        uint64_t sourceHash;
+        HTextureCodec codec;
+        uint32_t width;
+        uint32_t height;
+        uint32_t levelCount;
+        uint64_t levelOffset;
+        uint64_t dataOffset;
+        uint64_t dataSize;
+    };
+
+    /// Encoded texture that lives in a memory-mapped cache file, ready to be copied into a staging buffer as is.
+    /// When the cache could not be written the same layout is kept in a heap buffer instead.
+    class HMappedTexture
+    {
+    public:
+        HMappedTexture(HMappedFile&& file) : file{std::move(file)}
+        {}
+
+        HMappedTexture(std::vector<std::byte>&& buffer) : buffer{std::move(buffer)}
+        {}
+
+        std::span<const std::byte> bytes() const
+        { return buffer.empty() ? file.bytes() : std::span<const std::byte>(buffer); }
+
+        const HTextureHeader& header() const
+        { return *reinterpret_cast<const HTextureHeader*>(bytes().data()); }
+
+        std::span<const HTextureLevel> levels() const
+        {
+            auto levelBytes = bytes().subspan(header().levelOffset, static_cast<size_t>(header().levelCount) * sizeof(HTextureLevel));
+            return {reinterpret_cast<const HTextureLevel*>(levelBytes.data()), header().levelCount};
+        }
+
+        std::span<const std::byte> data() const
+        { return bytes().subspan(header().dataOffset, header().dataSize); }
+
+    private:
+        HMappedFile file;
+        std::vector<std::byte> buffer;
+    };
+
+    class HTextureCache
+    {
+    public:
+        /// Maps the cache file next to sourcePath, decoding and compressing the source first when the cache is missing or stale.
+        /// Calling it ahead of time for every texture and codec prebuilds the caches offline.
+        static HMappedTexture loadOrCompress(const std::string& sourcePath, HTextureCodec codec);
+
+        static std::optional<HMappedTexture> load(const std::string& cachePath, uint64_t sourceHash, HTextureCodec codec);
+
+        /// The cache file contents: header, level table and encoded data.
+        static std::vector<std::byte> serialize(const HTextureData& texture, uint64_t sourceHash);
+
+        static std::string cachePathFor(const std::string& sourcePath, HTextureCodec codec)
+        { return sourcePath + "." + std::to_string(static_cast<uint32_t>(codec)) + ".htex"; }
+    };
+
+} // Hellion
+
+#endif //HELLION_HTEXTURECACHE_H
@@ -0,0 +1,68 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HTEXTURECOMPRESSOR_H
+#define HELLION_HTEXTURECOMPRESSOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+namespace Hellion
+{
+    enum class HTextureCodec : uint32_t
+    {
+        /// uncompressed sRGB, 4 bytes per texel
+        Rgba8,
+        /// sRGB color without alpha, 0.5 bytes per texel
+        BC1,
+        /// sRGB color with alpha, 1 byte per texel
+        BC3,
+        /// single linear channel (masks, roughness), 0.5 bytes per texel
+        BC4,
+        /// two linear channels (tangent space normal xy), 1 byte per texel
+        BC5
+    };
+
+    struct HTextureLevel
+    {
+        uint32_t width;
+        uint32_t height;
+        /// relative to the start of the texel data
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    struct HTextureData
+    {
+        HTextureCodec codec = HTextureCodec::Rgba8;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<HTextureLevel> levels;
+        std::vector<std::byte> bytes;
+    };
+
+    /// Block compression with the bundled stb_dxt.
+    class HTextureCompressor
+    {
+    public:
+        static vk::Format vulkanFormat(HTextureCodec codec);
+
+        static uint64_t levelSize(HTextureCodec codec, uint32_t width, uint32_t height);
+
+        /// Full RGBA8 mip chain down to 1x1, level 0 is a copy of the input.
+        static std::vector<std::vector<uint8_t>> generateMipChain(const uint8_t* rgba, uint32_t width, uint32_t height, bool srgb);
+
+        /// Builds the full mip chain of an RGBA8 image and encodes every level. Block rows of all levels are compressed in parallel.
+        static HTextureData build(const uint8_t* rgba, uint32_t width, uint32_t height, HTextureCodec codec);
+
+    private:
+        static void compressBlock(HTextureCodec codec, const uint8_t* rgba, size_t stride, uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+                                  std::byte* out);
+    };
+
+} // Hellion
+
+#endif //HELLION_HTEXTURECOMPRESSOR_H
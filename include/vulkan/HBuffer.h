@@ -11,7 +11,7 @@
 namespace Hellion
 {
 
-    class HBuffer
+    class HBuffer : public HMovable
     {
     public:
         HBuffer(
@@ -19,20 +19,35 @@ namespace Hellion
                 vk::DeviceSize bufferSize,
                 vk::BufferUsageFlags usageFlags,
                 VmaAllocationCreateFlags memoryPropertyFlags,
-                vk::DeviceSize minOffsetAlignment = 1) : device{device},
-                                                         bufferSize{bufferSize},
-                                                         usageFlags{usageFlags},
-                                                         memoryPropertyFlags{memoryPropertyFlags}
+                vk::DeviceSize minOffsetAlignment = 1,
+                bool shareWithCompute = false) : device{device},
+                                                 bufferSize{bufferSize},
+                                                 usageFlags{usageFlags},
+                                                 memoryPropertyFlags{memoryPropertyFlags},
+                                                 shareWithCompute{shareWithCompute}
         {
-            auto [vmaAlloc, vmaAllocInfo] = device.createBufferVma(bufferSize, usageFlags, buffer, memoryPropertyFlags);
+            auto [vmaAlloc, vmaAllocInfo] = device.createBufferVma(bufferSize, usageFlags, buffer, memoryPropertyFlags, shareWithCompute);
             allocation = vmaAlloc;
             info = vmaAllocInfo;
         }
 
-        ~HBuffer()
+        ~HBuffer() override
         {
            // unmap();
-            vmaDestroyBuffer(device.getAllocator(), buffer, allocation);
+            auto& defragmenter = device.getDefragmenter();
+            if(defragmenter.release(allocation))
+            {
+                device.releaseAllocation(allocation);
+                // the pass's copy still uses both buffers until its fence signals
+                defragmenter.retire(buffer);
+                if(movedBuffer)
+                    defragmenter.retire(movedBuffer);
+            } else
+            {
+                if(movedBuffer)
+                    device.getDevice().destroyBuffer(movedBuffer);
+                device.destroyBuffer(buffer, allocation);
+            }
 //            vkDestroyBuffer(lveDevice.device(), buffer, nullptr);
 //            vkFreeMemory(lveDevice.device(), memory, nullptr);
         }
@@ -97,6 +112,14 @@ namespace Hellion
         vk::DeviceSize getBufferSize() const
         { return bufferSize; }
 
+        /// Lets the defragmenter move the buffer, it needs eTransferSrc and eTransferDst usage. Only for device local buffers
+        /// written through copies on the graphics queue whose users fetch getBuffer every frame, descriptor sets are not rewritten.
+        void enableDefragmentation();
+
+        void recordMove(vk::CommandBuffer commandBuffer, VmaAllocation dstAllocation) override;
+
+        void finishMove() override;
+
     private:
         static vk::DeviceSize getAlignment(vk::DeviceSize instanceSize, vk::DeviceSize minOffsetAlignment)
         {
@@ -110,12 +133,15 @@ namespace Hellion
         HDevice& device;
         void* mapped = nullptr;
         vk::Buffer buffer = VK_NULL_HANDLE;
+        /// the buffer before a move, kept until the defragmenter's copy has executed
+        vk::Buffer movedBuffer = VK_NULL_HANDLE;
         VmaAllocation allocation;
         VmaAllocationInfo info;
 
         vk::DeviceSize bufferSize;
         vk::BufferUsageFlags usageFlags;
         VmaAllocationCreateFlags memoryPropertyFlags;
+        bool shareWithCompute;
     };
 
 } // Hellion
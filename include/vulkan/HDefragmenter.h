@@ -0,0 +1,126 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HDEFRAGMENTER_H
+#define HELLION_HDEFRAGMENTER_H
+
+#include <vulkan/vulkan.hpp>
+#include <vk_mem_alloc.h>
+#include <cstdint>
+#include <vector>
+
+namespace Hellion
+{
+    class HDevice;
+
+    /// A resource that lets the defragmenter move its allocation. Allocations without one are never moved.
+    class HMovable
+    {
+    public:
+        virtual ~HMovable() = default;
+
+        /// Creates the replacement bound to allocation, records the copy of the contents into commandBuffer and switches to it.
+        /// The old handle stays alive until finishMove, frames submitted before the copy may still use it.
+        virtual void recordMove(vk::CommandBuffer commandBuffer, VmaAllocation allocation) = 0;
+
+        /// No frame uses the old handle anymore, destroy it without freeing its memory.
+        virtual void finishMove() = 0;
+    };
+
+    struct HDefragmentationStats
+    {
+        uint64_t bytesMoved = 0;
+        uint64_t bytesFreed = 0;
+        uint32_t allocationsMoved = 0;
+        uint32_t blocksFreed = 0;
+        uint32_t passes = 0;
+        uint32_t sessions = 0;
+        bool running = false;
+    };
+
+    /// Compacts the texture pool and the default pools in the background, a bounded number of moves per frame.
+    /// A pass submits its copies on the graphics queue without waiting, everything submitted later sees the new resources.
+    /// The pass ends once its fence signaled, by then no earlier frame uses the old ones either.
+    class HDefragmenter
+    {
+    public:
+        static constexpr vk::DeviceSize MAX_BYTES_PER_PASS = 16ull * 1024 * 1024;
+        static constexpr uint32_t MAX_MOVES_PER_PASS = 32;
+        /// frames between two looks at the pools' free space
+        static constexpr uint32_t CHECK_INTERVAL = 120;
+        /// a pool is compacted when this much of its blocks is unused
+        static constexpr vk::DeviceSize MIN_WASTED_BYTES = 16ull * 1024 * 1024;
+        static constexpr float MIN_WASTED_RATIO = 0.25f;
+
+        HDefragmenter() = default;
+
+        HDefragmenter(const HDefragmenter&) = delete;
+
+        HDefragmenter& operator=(const HDefragmenter&) = delete;
+
+        void init(HDevice& device, VmaPool texturePool);
+
+        /// Waits for and ends a running session.
+        void destroy();
+
+        /// Once per frame, before its descriptor sets are written.
+        void update();
+
+        /// Lets the allocation be moved, the resource is found again through the allocation's user data.
+        void track(VmaAllocation allocation, HMovable* resource);
+
+        /// Call before freeing an allocation. Returns true when it is part of the running pass,
+        /// the owner then hands its handles to retire and the pass frees the memory.
+        bool release(VmaAllocation allocation);
+
+        /// Destroys the handle when the running pass ends, its copy commands may still be executing.
+        void retire(vk::Image image)
+        { retiredImages.push_back(image); }
+
+        void retire(vk::ImageView view)
+        { retiredViews.push_back(view); }
+
+        void retire(vk::Buffer buffer)
+        { retiredBuffers.push_back(buffer); }
+
+        void setEnabled(bool enable)
+        { enabled = enable; }
+
+        bool isEnabled() const
+        { return enabled; }
+
+        const HDefragmentationStats& getStats() const
+        { return stats; }
+
+    private:
+        /// Pool with the most unused memory, if any is worth compacting.
+        bool pickPool(VmaPool& pool);
+
+        void beginSession(VmaPool pool);
+
+        void recordPass();
+
+        void endPass();
+
+        void endSession();
+
+        HDevice* device = nullptr;
+        VmaAllocator allocator = VK_NULL_HANDLE;
+        VmaPool texturePool = VK_NULL_HANDLE;
+        VmaDefragmentationContext context = VK_NULL_HANDLE;
+        VmaDefragmentationPassMoveInfo pass{};
+        vk::CommandBuffer commandBuffer = nullptr;
+        vk::Fence fence = nullptr;
+        /// handles of resources freed while the pass was running
+        std::vector<vk::Image> retiredImages;
+        std::vector<vk::ImageView> retiredViews;
+        std::vector<vk::Buffer> retiredBuffers;
+        uint64_t frame = 0;
+        bool enabled = true;
+        HDefragmentationStats stats;
+    };
+
+} // Hellion
+
+#endif //HELLION_HDEFRAGMENTER_H
@@ -7,6 +7,7 @@
 
 #include <vulkan/vulkan.hpp>
 #include <memory>
+#include <memory_resource>
 #include "HDevice.h"
 #include <unordered_map>
 
@@ -171,8 +172,9 @@ namespace Hellion
     class HDescriptorWriter
     {
     public:
-        HDescriptorWriter(HDescriptorSetLayout& setLayout, HDescriptorPool& pool)
-                : setLayout{setLayout}, pool{pool}
+        /// Writes made every frame can pass the renderer's frame arena as memory.
+        HDescriptorWriter(HDescriptorSetLayout& setLayout, HDescriptorPool& pool, std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+                : setLayout{setLayout}, pool{pool}, writes{memory}
         {}
 
         HDescriptorWriter& writeBuffer(uint32_t binding, vk::DescriptorBufferInfo* bufferInfo)
@@ -230,7 +232,7 @@ namespace Hellion
     private:
         HDescriptorSetLayout& setLayout;
         HDescriptorPool& pool;
-        std::vector<vk::WriteDescriptorSet> writes;
+        std::pmr::vector<vk::WriteDescriptorSet> writes;
     };
 
 } // Hellion
@@ -8,11 +8,17 @@
 #include <GLFW/glfw3.h>
 #include <vulkan/vulkan.hpp>
 #include <fmt/core.h>
+#include <span>
 #include "HWindow.h"
 #include <optional>
+#include <map>
+#include <mutex>
 #include <set>
 #include <vk_mem_alloc.h>
 #include "../core/Profiling.h"
+#include "../core/HAllocationTracker.h"
+#include "HSamplerCache.h"
+#include "HDefragmenter.h"
 
 namespace Hellion
 {
@@ -20,11 +26,47 @@ namespace Hellion
     {
         std::optional<uint32_t> graphicsFamily;
         std::optional<uint32_t> presentFamily;
+        std::optional<uint32_t> computeFamily;
 
         bool isComplete()
         {
             return graphicsFamily.has_value() && presentFamily.has_value();
         }
+
+        bool hasDedicatedCompute()
+        {
+            return computeFamily.has_value() && computeFamily != graphicsFamily;
+        }
+    };
+
+    struct HTimelinePoint
+    {
+        vk::Semaphore semaphore;
+        uint64_t value;
+        vk::PipelineStageFlags stage = vk::PipelineStageFlagBits::eAllCommands;
+    };
+
+    struct HCategoryUsage
+    {
+        vk::DeviceSize bytes = 0;
+        uint32_t allocations = 0;
+    };
+
+    /// Live memory objects next to what the image allocation policy decided since startup.
+    struct HAllocationStats
+    {
+        /// VkDeviceMemory objects, dedicated allocations included
+        uint32_t memoryBlocks = 0;
+        uint32_t allocations = 0;
+        vk::DeviceSize blockBytes = 0;
+        vk::DeviceSize allocationBytes = 0;
+        uint32_t texturePoolBlocks = 0;
+        uint32_t texturePoolAllocations = 0;
+        uint32_t maxMemoryAllocations = 0;
+        uint64_t dedicatedImages = 0;
+        uint64_t pooledImages = 0;
+        uint64_t lazyImages = 0;
+        uint64_t defaultImages = 0;
     };
 
     struct SwapChainSupportDetails
@@ -44,16 +86,42 @@ namespace Hellion
                 VK_KHR_SWAPCHAIN_EXTENSION_NAME,
                 VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME
         };
+        const std::vector<const char*> optionalDeviceExtensions = {
+                VK_KHR_PRESENT_ID_EXTENSION_NAME,
+                VK_KHR_PRESENT_WAIT_EXTENSION_NAME,
+                VK_EXT_MEMORY_BUDGET_EXTENSION_NAME
+        };
+        std::set<std::string> enabledExtensions;
+        bool presentWaitSupported = false;
+        bool multiDrawIndirectSupported = false;
+        bool pipelineStatisticsSupported = false;
 
         VmaAllocator g_hAllocator;
+        /// sampled images share large blocks instead of getting a vkAllocateMemory each
+        VmaPool texturePool = VK_NULL_HANDLE;
+        uint32_t texturePoolMemoryType = UINT32_MAX;
+        bool lazilyAllocatedSupported = false;
+        HAllocationStats imageCounts;
+        /// textures are created on the streamer's upload path as well as the render thread
+        mutable std::mutex categoryMutex;
+        std::map<std::string, HCategoryUsage, std::less<>> categoryUsage;
+        HDefragmenter defragmenter;
 
         vk::PhysicalDevice physicalDevice{nullptr};
+        vk::PhysicalDeviceProperties properties;
+        vk::PhysicalDeviceFeatures features;
+        vk::PhysicalDeviceMemoryProperties memoryProperties;
         vk::Device device;
+        HSamplerCache samplerCache;
 
         vk::Queue presentQueue;
         vk::Queue graphicsQueue;
+        vk::Queue computeQueue;
+        uint32_t graphicsFamilyIndex = 0;
+        uint32_t computeFamilyIndex = 0;
 
         vk::CommandPool commandPool;
+        vk::CommandPool computeCommandPool;
 
         vk::Instance instance{nullptr};
         vk::DebugUtilsMessengerEXT debugMessenger{nullptr};
@@ -87,21 +155,69 @@ namespace Hellion
         vk::PhysicalDevice& getPhysicalDevice()
         { return physicalDevice; }
 
+        const vk::PhysicalDeviceProperties& getProperties() const
+        { return properties; }
+
+        const vk::PhysicalDeviceFeatures& getFeatures() const
+        { return features; }
+
+        const vk::PhysicalDeviceMemoryProperties& getMemoryProperties() const
+        { return memoryProperties; }
+
+        /// Shared sampler for the description, owned by the device. Do not destroy it.
+        vk::Sampler getSampler(const vk::SamplerCreateInfo& info)
+        { return samplerCache.get(device, info); }
+
+        size_t getSamplerCount() const
+        { return samplerCache.size(); }
+
         vk::Queue getPresentQueue()
         { return presentQueue; }
 
         vk::Queue& getGraphicsQueue()
         { return graphicsQueue; }
 
+        vk::Queue& getComputeQueue()
+        { return computeQueue; }
+
+        uint32_t getGraphicsFamily() const
+        { return graphicsFamilyIndex; }
+
+        uint32_t getComputeFamily() const
+        { return computeFamilyIndex; }
+
         vk::SurfaceKHR& getSurface()
         { return surface; }
 
         vk::CommandPool& getCommandPool()
         { return commandPool; }
 
+        vk::CommandPool& getComputeCommandPool()
+        { return computeCommandPool; }
+
+        bool hasAsyncCompute()
+        { return computeQueue != graphicsQueue; }
+
         VmaAllocator getAllocator()
         { return g_hAllocator; }
 
+        /// Background compaction of the texture pool and the default pools, resources opt in through track.
+        HDefragmenter& getDefragmenter()
+        { return defragmenter; }
+
+        bool isExtensionEnabled(const char* extension) const
+        { return enabledExtensions.contains(extension); }
+
+        bool supportsPresentWait() const
+        { return presentWaitSupported; }
+
+        /// without multiDrawIndirect every indirect draw has to be recorded with a drawCount of 1
+        bool supportsMultiDrawIndirect() const
+        { return multiDrawIndirectSupported; }
+
+        bool supportsPipelineStatistics() const
+        { return pipelineStatisticsSupported; }
+
         bool hasStencilComponent(vk::Format format)
         { return format == vk::Format::eD32SfloatS8Uint || format == vk::Format::eD24UnormS8Uint; }
 
@@ -138,10 +254,13 @@ namespace Hellion
         }
 
         std::pair<VmaAllocation, VmaAllocationInfo>
-        createBufferVma(vk::DeviceSize size, vk::BufferUsageFlags usage, vk::Buffer& buffer, VmaAllocationCreateFlags flags);
+        createBufferVma(vk::DeviceSize size, vk::BufferUsageFlags usage, vk::Buffer& buffer, VmaAllocationCreateFlags flags,
+                        bool shareWithCompute = false);
 
         void copyBuffer(vk::Buffer srcBuffer, vk::Buffer dstBuffer, vk::DeviceSize size);
 
+        void copyBuffer(vk::Buffer srcBuffer, vk::Buffer dstBuffer, std::span<const vk::BufferCopy> regions);
+
         vk::CommandBuffer beginSingleTimeCommands();
 
         void endSingleTimeCommands(vk::CommandBuffer& commandBuffer);
@@ -150,27 +269,71 @@ namespace Hellion
         createImage(uint32_t width, uint32_t height, uint32_t mipLevels, vk::Format format, vk::ImageTiling tiling, vk::ImageUsageFlags usage,
                     vk::ImageCreateFlags flags, uint32_t arrayLayers);
 
-        std::pair<vk::Image, VmaAllocation> createImageWithInfo(vk::ImageCreateInfo& imageInfo)
+        /// Allocates through the image allocation policy, see imageAllocationInfo.
+        std::pair<vk::Image, VmaAllocation> createImageWithInfo(vk::ImageCreateInfo& imageInfo);
+
+        /// Render targets of at least this many texels get their own memory, they are few and large and resized as a whole.
+        static constexpr vk::DeviceSize DEDICATED_IMAGE_TEXELS = 2048ull * 2048ull;
+        static constexpr vk::DeviceSize TEXTURE_POOL_BLOCK_SIZE = 64ull * 1024 * 1024;
+
+        HAllocationStats getAllocationStats();
+
+        /// Live allocations grouped by category, counted on the create and destroy paths so nothing walks the allocations.
+        std::map<std::string, HCategoryUsage> getCategoryUsage() const;
+
+        /// Call before an allocation made through HDevice is freed by anything but destroyImage and destroyBuffer,
+        /// e.g. when a defragmentation pass frees it.
+        void releaseAllocation(VmaAllocation allocation);
+
+        void destroyImage(vk::Image image, VmaAllocation allocation)
+        {
+            releaseAllocation(allocation);
+            vmaDestroyImage(g_hAllocator, image, allocation);
+        }
+
+        void destroyBuffer(vk::Buffer buffer, VmaAllocation allocation)
         {
-            VmaAllocationCreateInfo allocCreateInfo = {};
-            allocCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
-            allocCreateInfo.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
-            allocCreateInfo.priority = 1.0f;
-            vk::Image img;
-            VmaAllocation alloc;
-            vmaCreateImage(g_hAllocator, reinterpret_cast<VkImageCreateInfo*>(&imageInfo), &allocCreateInfo, reinterpret_cast<VkImage*>(&img), &alloc, nullptr);
-            return {img, alloc};
+            releaseAllocation(allocation);
+            vmaDestroyBuffer(g_hAllocator, buffer, allocation);
         }
 
+        /// Whether vmaGetHeapBudgets reports the driver's numbers, otherwise VMA estimates 80% of each heap.
+        bool hasMemoryBudget() const
+        { return isExtensionEnabled(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME); }
+
+        void printAllocationStats();
+
         void transitionImageLayout(vk::Image image, vk::Format format, vk::ImageLayout oldLayout, vk::ImageLayout newLayout, uint32_t mipLevels,
                                    uint32_t layerCount);
 
+        /// Records the barrier into commandBuffer instead of submitting and waiting for it.
+        void transitionImageLayout(vk::CommandBuffer commandBuffer, vk::Image image, vk::Format format, vk::ImageLayout oldLayout,
+                                   vk::ImageLayout newLayout, uint32_t mipLevels, uint32_t layerCount);
+
         void copyBufferToImage(vk::Buffer buffer, vk::Image image, uint32_t width, uint32_t height);
 
+        /// Copies every region in one command buffer, e.g. all mip levels of a texture.
+        void copyBufferToImage(vk::Buffer buffer, vk::Image image, std::span<const vk::BufferImageCopy> regions);
+
+        /// Budget and usage summed over the device local heaps, as estimated by VMA.
+        VmaBudget getDeviceLocalBudget();
+
+        /// Whether optimal tiling images of the format can be sampled with a linear filter, block compressed formats are optional.
+        bool supportsSampledFormat(vk::Format format);
+
+        /// Whether generateMipmaps can be used for the format, blitting with a linear filter is optional for many formats.
+        bool supportsLinearBlit(vk::Format format);
+
+        /// Fills mip levels 1..mipLevels-1 by blitting from level 0, which must be in eTransferDstOptimal.
+        /// All levels end up in eShaderReadOnlyOptimal.
+        void generateMipmaps(vk::Image image, vk::Format format, int32_t width, int32_t height, uint32_t mipLevels);
+
         vk::ImageView createImageView(vk::Image& image, vk::Format format, vk::ImageAspectFlags aspectFlags, uint32_t mipLevels, vk::ImageViewType viewType);
 
         vk::Format findSupportedFormat(const std::vector<vk::Format>& candidates, vk::ImageTiling tiling, vk::FormatFeatureFlags features);
 
+        vk::Semaphore createTimelineSemaphore(uint64_t initialValue = 0);
+
         vk::DispatchLoaderDynamic& getDldi()
         { return dldi; }
 
@@ -187,6 +350,21 @@ namespace Hellion
 
         void createVmaAllocator();
 
+        void createTexturePool();
+
+        /// Transient attachments go to lazily allocated memory where it exists, large render targets get dedicated memory,
+        /// sampled images are suballocated from the texture pool. Everything else is left to VMA, which also honors the
+        /// driver's prefersDedicatedAllocation through the Vulkan 1.1 memory requirements query.
+        VmaAllocationCreateInfo imageAllocationInfo(const vk::ImageCreateInfo& imageInfo);
+
+        /// Resource category an allocation is named after, the memory statistics are grouped by it.
+        static const char* allocationCategory(vk::BufferUsageFlags usage, VmaAllocationCreateFlags flags);
+
+        static const char* allocationCategory(vk::ImageUsageFlags usage);
+
+        /// Names the allocation after its category and counts it.
+        void trackAllocation(VmaAllocation allocation, const char* category);
+
         void createCommandPool();
 
         bool supported(std::vector<const char*>& extensions, const std::vector<const char*>& layers, bool debug);
@@ -0,0 +1,111 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HFRAMEPACER_H
+#define HELLION_HFRAMEPACER_H
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include "HSwapChain.h"
+
+namespace Hellion
+{
+    struct HLatencyStats
+    {
+        uint64_t samples = 0;
+        double totalMs = 0.0;
+        double minMs = std::numeric_limits<double>::max();
+        double maxMs = 0.0;
+
+        void add(double ms)
+        {
+            samples++;
+            totalMs += ms;
+            minMs = std::min(minMs, ms);
+            maxMs = std::max(maxMs, ms);
+        }
+
+        double averageMs() const
+        { return samples == 0 ? 0.0 : totalMs / static_cast<double>(samples); }
+    };
+
+    /// Frame rate limiter and input-to-present latency meter.
+    /// With VK_KHR_present_wait the latency is measured up to the moment the image reached the display,
+    /// otherwise up to the moment the GPU finished the frame.
+    class HFramePacer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t POLICY_COUNT = 4;
+
+        void setTargetFps(double fps)
+        { targetFps = fps; }
+
+        double getTargetFps() const
+        { return targetFps; }
+
+        void setPresentWait(bool enable)
+        { presentWait = enable; }
+
+        bool usesPresentWait() const
+        { return presentWait; }
+
+        /// Sleeps until the next frame slot of the frame rate limiter, no-op when targetFps is 0.
+        void limit();
+
+        /// Should be called right after input was polled.
+        void markInputSampled()
+        { inputTime = Clock::now(); }
+
+        /// Throttles the CPU so that at most presentWaitLag presents are queued in the presentation engine.
+        void waitForPresents(HSwapChain& swapChain);
+
+        void onFrameSubmitted(uint64_t presentId, HPresentPolicy policy);
+
+        /// Fallback measurement point for devices without present wait: the frame fence of the oldest pending frame was just waited on.
+        void onFrameRetired();
+
+        /// Polls present completion without blocking and records latency samples.
+        void collect(HSwapChain& swapChain);
+
+        /// Pending presents belong to a retired swapchain and can not be waited on anymore.
+        void dropPending()
+        { pending.clear(); }
+
+        const HLatencyStats& getStats(HPresentPolicy policy) const
+        { return stats[static_cast<size_t>(policy)]; }
+
+        void report() const;
+
+    private:
+        struct PendingFrame
+        {
+            uint64_t presentId;
+            Clock::time_point inputTime;
+            HPresentPolicy policy;
+        };
+
+        void record(const PendingFrame& frame, Clock::time_point presented)
+        {
+            double ms = std::chrono::duration<double, std::milli>(presented - frame.inputTime).count();
+            stats[static_cast<size_t>(frame.policy)].add(ms);
+        }
+
+        double targetFps = 0.0;
+        bool presentWait = false;
+        uint64_t presentWaitLag = 1;
+
+        Clock::time_point inputTime = Clock::now();
+        Clock::time_point nextFrame = Clock::now();
+        std::deque<PendingFrame> pending;
+        std::array<HLatencyStats, POLICY_COUNT> stats{};
+    };
+
+    const char* toString(HPresentPolicy policy);
+
+} // Hellion
+
+#endif //HELLION_HFRAMEPACER_H
@@ -0,0 +1,118 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HGEOMETRYARENA_H
+#define HELLION_HGEOMETRYARENA_H
+
+#include <memory>
+#include <span>
+#include <vector>
+#include "HDevice.h"
+#include "HBuffer.h"
+#include "../core/HRangeAllocator.h"
+
+namespace Hellion
+{
+    struct HGeometryHandle
+    {
+        uint32_t index = UINT32_MAX;
+        /// bumped on release so stale handles are detected
+        uint32_t generation = 0;
+
+        bool isValid() const
+        { return index != UINT32_MAX; }
+    };
+
+    /// Where a mesh lives inside the arena buffers, in the units drawIndexed expects.
+    struct HGeometryRange
+    {
+        int32_t vertexOffset = 0;
+        uint32_t vertexCount = 0;
+        uint32_t vertexStride = 0;
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+    };
+
+    /// Device-local vertex and index buffers shared by every mesh. Meshes are suballocated ranges addressed by handles,
+    /// so all draws share one bind and select their mesh with vertexOffset and firstIndex.
+    class HGeometryArena
+    {
+    public:
+        static constexpr vk::DeviceSize DEFAULT_VERTEX_CAPACITY = 64ull * 1024 * 1024;
+        static constexpr uint32_t DEFAULT_INDEX_CAPACITY = 16u * 1024 * 1024;
+
+        HGeometryArena(HDevice& device, vk::DeviceSize vertexCapacity = DEFAULT_VERTEX_CAPACITY, uint32_t indexCapacity = DEFAULT_INDEX_CAPACITY);
+
+        ~HGeometryArena();
+
+        HGeometryArena(const HGeometryArena&) = delete;
+
+        HGeometryArena& operator=(const HGeometryArena&) = delete;
+
+        /// Copies the mesh into the arena, defragmenting once when the free space is too fragmented for it.
+        HGeometryHandle upload(std::span<const std::byte> vertexBytes, uint32_t vertexStride, std::span<const uint32_t> indices);
+
+        /// The caller must make sure no frame in flight still draws the mesh.
+        void release(HGeometryHandle handle);
+
+        const HGeometryRange& getRange(HGeometryHandle handle) const;
+
+        void bind(vk::CommandBuffer buffer) const;
+
+        /// Moves every live range to the front of a fresh pair of buffers, handles stay valid. The copy is submitted without waiting,
+        /// the old buffers are freed by update once it finished. Returns false and leaves the arena untouched when the ranges don't fit.
+        bool defragment();
+
+        /// Once per frame, frees the buffers replaced by defragment whose copy finished.
+        void update();
+
+        vk::DeviceSize getVertexFreeSpace() const
+        { return vertexAllocator.getFreeSpace(); }
+
+        uint32_t getIndexFreeSpace() const
+        { return static_cast<uint32_t>(indexAllocator.getFreeSpace()); }
+
+    private:
+        struct Slot
+        {
+            HGeometryRange range;
+            uint32_t generation = 0;
+            bool live = false;
+        };
+
+        bool allocate(Slot& slot, vk::DeviceSize vertexBytes, uint32_t vertexStride, uint32_t indexCount);
+
+        std::unique_ptr<HBuffer> createVertexBuffer() const;
+
+        std::unique_ptr<HBuffer> createIndexBuffer() const;
+
+        /// Buffers replaced by defragment, frames submitted before the copy may still read them until its fence signals.
+        struct RetiredBuffers
+        {
+            std::unique_ptr<HBuffer> vertexBuffer;
+            std::unique_ptr<HBuffer> indexBuffer;
+            vk::CommandBuffer commandBuffer;
+            vk::Fence fence;
+        };
+
+        void destroyRetired(RetiredBuffers& buffers);
+
+        HDevice& device;
+        vk::DeviceSize vertexCapacity;
+        uint32_t indexCapacity;
+        /// in bytes, vertex ranges are aligned to their stride
+        HRangeAllocator vertexAllocator;
+        /// in indices
+        HRangeAllocator indexAllocator;
+        std::unique_ptr<HBuffer> vertexBuffer;
+        std::unique_ptr<HBuffer> indexBuffer;
+
+        std::vector<Slot> slots;
+        std::vector<uint32_t> freeSlots;
+        std::vector<RetiredBuffers> retired;
+    };
+
+} // Hellion
+
+#endif //HELLION_HGEOMETRYARENA_H
@@ -0,0 +1,141 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HGPUQUERIES_H
+#define HELLION_HGPUQUERIES_H
+
+#include <vulkan/vulkan.hpp>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "HSwapChain.h"
+
+namespace Hellion
+{
+    class HDevice;
+
+    /// GPU time and pipeline statistics of one named pass, times are in milliseconds.
+    struct HGpuPassStats
+    {
+        const char* name = nullptr;
+        double lastMs = 0.0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+        /// frames with results for the pass
+        uint64_t frames = 0;
+        /// counts of the last result, 0 while pipeline statistics are off
+        uint64_t vertexInvocations = 0;
+        uint64_t clippingPrimitives = 0;
+        uint64_t fragmentInvocations = 0;
+
+        double averageMs() const
+        { return frames > 0 ? totalMs / static_cast<double>(frames) : 0.0; }
+    };
+
+    /// Timestamp and pipeline statistics queries of the graphics command buffer. Every frame slot has its own range of queries,
+    /// the results are read when the slot comes around again, after its fence was waited on, so reading never stalls.
+    class HGpuQueries
+    {
+    public:
+        static constexpr uint32_t MAX_PASSES = 8;
+
+        void init(HDevice& device);
+
+        void destroy();
+
+        /// Collects the results of the frame that last used slot, then resets its queries. Must be recorded outside of a render pass.
+        void beginFrame(vk::CommandBuffer commandBuffer, uint32_t slot, uint64_t frame);
+
+        void endFrame(vk::CommandBuffer commandBuffer);
+
+        /// Passes can not nest, pipeline statistics queries have to begin and end in the same subpass.
+        /// name must outlive the queries, e.g. a string literal.
+        void beginPass(vk::CommandBuffer commandBuffer, const char* name);
+
+        void endPass(vk::CommandBuffer commandBuffer);
+
+        bool isSupported() const
+        { return static_cast<bool>(timestampPool); }
+
+        bool supportsPipelineStatistics() const
+        { return static_cast<bool>(statisticsPool); }
+
+        /// Pipeline statistics have a cost on some drivers, they are off until enabled.
+        void setPipelineStatistics(bool enable)
+        { pipelineStatistics = enable && supportsPipelineStatistics(); }
+
+        bool usesPipelineStatistics() const
+        { return pipelineStatistics; }
+
+        const std::vector<HGpuPassStats>& getPasses() const
+        { return passes; }
+
+        /// nullptr until the pass has been recorded once
+        const HGpuPassStats* findPass(std::string_view name) const;
+
+        /// whole command buffer time of the last frame with results
+        double getFrameMs() const
+        { return frameMs; }
+
+        /// HProfiler frame the current results belong to
+        uint64_t getResultFrame() const
+        { return resultFrame; }
+
+        /// Per pass averages and peaks, printed on exit.
+        void report() const;
+
+    private:
+        static constexpr uint32_t TIMESTAMPS_PER_SLOT = 2 + MAX_PASSES * 2;
+        /// vertex shader invocations, clipping primitives and fragment shader invocations, in the order of their flag bits
+        static constexpr uint32_t STATISTICS_COUNT = 3;
+
+        struct Slot
+        {
+            uint64_t frame = 0;
+            uint32_t passCount = 0;
+            /// indices into passes
+            std::array<uint32_t, MAX_PASSES> passIndices{};
+            bool written = false;
+            bool statistics = false;
+        };
+
+        void readResults(Slot& slot);
+
+        HDevice* device = nullptr;
+        vk::QueryPool timestampPool;
+        vk::QueryPool statisticsPool;
+        uint64_t timestampMask = ~0ull;
+        double timestampPeriod = 1.0;
+        bool pipelineStatistics = false;
+
+        std::array<Slot, HSwapChain::MAX_FRAMES_IN_FLIGHT> slots{};
+        uint32_t currentSlot = 0;
+        bool passActive = false;
+        std::vector<HGpuPassStats> passes;
+        double frameMs = 0.0;
+        uint64_t resultFrame = 0;
+    };
+
+    class HGpuPassScope
+    {
+    public:
+        HGpuPassScope(HGpuQueries& queries, vk::CommandBuffer commandBuffer, const char* name) : queries{queries}, commandBuffer{commandBuffer}
+        { queries.beginPass(commandBuffer, name); }
+
+        ~HGpuPassScope()
+        { queries.endPass(commandBuffer); }
+
+        HGpuPassScope(const HGpuPassScope&) = delete;
+
+        HGpuPassScope& operator=(const HGpuPassScope&) = delete;
+
+    private:
+        HGpuQueries& queries;
+        vk::CommandBuffer commandBuffer;
+    };
+
+} // Hellion
+
+#endif //HELLION_HGPUQUERIES_H
@@ -0,0 +1,76 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HMEMORYMONITOR_H
+#define HELLION_HMEMORYMONITOR_H
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "HDevice.h"
+
+namespace Hellion
+{
+    struct HHeapBudget
+    {
+        vk::DeviceSize size = 0;
+        vk::DeviceSize budget = 0;
+        vk::DeviceSize usage = 0;
+        /// bytes in VkDeviceMemory blocks and in live allocations, as allocated through VMA
+        vk::DeviceSize blockBytes = 0;
+        vk::DeviceSize allocationBytes = 0;
+        uint32_t blockCount = 0;
+        uint32_t allocationCount = 0;
+        bool deviceLocal = false;
+    };
+
+    /// Polls the VMA heap budgets once per frame, warns when a heap gets close to its budget and lets systems that can give memory
+    /// back (e.g. the texture streamer) react through pressure callbacks.
+    class HMemoryMonitor
+    {
+    public:
+        /// usage above this fraction of a heap budget counts as pressure
+        static constexpr float WARNING_RATIO = 0.9f;
+        /// the per-category breakdown is copied out of HDevice's counters at this interval
+        static constexpr uint64_t CATEGORY_REFRESH_FRAMES = 60;
+
+        using PressureCallback = std::function<void(uint32_t heap, vk::DeviceSize excess)>;
+
+        explicit HMemoryMonitor(HDevice& device) : device{device}
+        {}
+
+        /// Called once per frame before any allocation of the frame.
+        void update();
+
+        /// Called with the bytes above WARNING_RATIO of the budget of a device local heap, every frame the heap stays there.
+        void addPressureCallback(PressureCallback callback)
+        { pressureCallbacks.push_back(std::move(callback)); }
+
+        const std::vector<HHeapBudget>& getHeaps() const
+        { return heaps; }
+
+        /// Live allocations grouped by the name HDevice gives them when they are created.
+        const std::map<std::string, HCategoryUsage>& getCategories() const
+        { return categories; }
+
+        /// Writes vmaBuildStatsString with every allocation together with the per-category summary.
+        void dumpJson(const std::string& path);
+
+        void drawUi();
+
+    private:
+        void refreshCategories();
+
+        HDevice& device;
+        std::vector<HHeapBudget> heaps;
+        std::vector<bool> heapWarned;
+        std::map<std::string, HCategoryUsage> categories;
+        std::vector<PressureCallback> pressureCallbacks;
+        uint64_t frame = 0;
+    };
+
+} // Hellion
+
+#endif //HELLION_HMEMORYMONITOR_H
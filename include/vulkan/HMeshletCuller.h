@@ -0,0 +1,77 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HMESHLETCULLER_H
+#define HELLION_HMESHLETCULLER_H
+
+#include <span>
+#include <glm/glm.hpp>
+#include <tracy/TracyVulkan.hpp>
+#include "HDevice.h"
+#include "HBuffer.h"
+#include "HPipeline.h"
+#include "HDescriptorSetLayout.h"
+#include "HGeometryArena.h"
+#include "../mesh/HMeshlet.h"
+
+namespace Hellion
+{
+    /// Frustum and normal cone culling of meshlets in a compute shader. Every meshlet gets one indexed indirect draw,
+    /// culled meshlets are written with an instanceCount of 0, so no mesh shader support is required.
+    class HMeshletCuller
+    {
+    public:
+        static constexpr const char* SHADER_PATH = "../Data/Shaders/cull.spv";
+        static constexpr uint32_t WORKGROUP_SIZE = 64;
+
+        HMeshletCuller(HDevice& device, std::span<const HMeshlet> meshlets);
+
+        ~HMeshletCuller();
+
+        HMeshletCuller(const HMeshletCuller&) = delete;
+
+        HMeshletCuller& operator=(const HMeshletCuller&) = delete;
+
+        /// Records the culling dispatch on the compute command buffer of the frame, viewProj and model are the matrices used for drawing.
+        /// The meshlet ranges are relative to the mesh, range places them in the geometry arena.
+        void cull(vk::CommandBuffer computeBuffer, uint32_t currentFrame, const HGeometryRange& range, const glm::mat4& viewProj, const glm::mat4& model,
+                  glm::vec3 cameraPosition, tracy::VkCtx* tracyCtx);
+
+        /// Draws the meshlets written by cull for the same frame, the index and vertex buffers must already be bound.
+        void draw(vk::CommandBuffer buffer, uint32_t currentFrame);
+
+        uint32_t getMeshletCount() const
+        { return meshletCount; }
+
+    private:
+        struct CullConstants
+        {
+            glm::vec4 frustum[6];
+            glm::vec4 cameraPosition;
+            uint32_t meshletCount;
+            uint32_t firstIndex;
+            int32_t vertexOffset;
+        };
+
+        void createBuffers(std::span<const HMeshlet> meshlets);
+
+        void createPipeline();
+
+        HDevice& device;
+        uint32_t meshletCount = 0;
+        uint32_t maxDrawCount = 1;
+        std::unique_ptr<HBuffer> meshletBuffer;
+        /// one per frame in flight, the compute queue writes the next frame while the graphics queue still reads the current one
+        std::vector<std::unique_ptr<HBuffer>> drawBuffers;
+
+        std::unique_ptr<HDescriptorPool> descriptorPool;
+        std::unique_ptr<HDescriptorSetLayout> descriptorSetLayout;
+        std::vector<vk::DescriptorSet> descriptorSets;
+        vk::PipelineLayout pipelineLayout;
+        std::unique_ptr<HPipeline> pipeline;
+    };
+
+} // Hellion
+
+#endif //HELLION_HMESHLETCULLER_H
@@ -0,0 +1,71 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HPERFOVERLAY_H
+#define HELLION_HPERFOVERLAY_H
+
+#include <cstdint>
+#include <vector>
+#include "HGpuQueries.h"
+
+namespace Hellion
+{
+    struct HFrameTimeStats
+    {
+        uint64_t samples = 0;
+        double averageMs = 0.0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    /// Frame time percentiles, hitches and a per system breakdown built from the HProfiler history and scopes and the GPU passes.
+    class HPerfOverlay
+    {
+    public:
+        /// a frame that takes this many times the running average is a hitch
+        static constexpr double HITCH_FACTOR = 2.0;
+        /// and at least this much longer, so that noise at high frame rates is not counted
+        static constexpr double HITCH_MIN_MS = 4.0;
+        static constexpr int HISTOGRAM_BUCKETS = 40;
+        static constexpr size_t TOP_SCOPES = 12;
+
+        explicit HPerfOverlay(HGpuQueries& gpuQueries) : gpuQueries{gpuQueries}
+        {}
+
+        /// Counts hitches in the frames closed since the last call, runs every frame.
+        void update();
+
+        /// The window starts collapsed, while it is collapsed only update runs and no statistics are computed.
+        void drawUi();
+
+        /// Statistics over the HProfiler history, gpu selects the GPU frame times.
+        HFrameTimeStats computeStats(bool gpu);
+
+        uint64_t getHitches() const
+        { return hitches; }
+
+        /// The overlay's statistics, printed on exit.
+        void report();
+
+    private:
+        void drawFrameTimes(const char* label, bool gpu);
+
+        HGpuQueries& gpuQueries;
+        uint64_t nextFrame = 0;
+        double runningAverageMs = 0.0;
+        uint64_t hitches = 0;
+        double lastHitchMs = 0.0;
+        uint64_t lastHitchFrame = 0;
+
+        /// reused between frames, in frame order and sorted
+        std::vector<float> timeline;
+        std::vector<float> sorted;
+        std::vector<size_t> scopeOrder;
+    };
+
+} // Hellion
+
+#endif //HELLION_HPERFOVERLAY_H
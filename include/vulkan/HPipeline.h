@@ -20,6 +20,7 @@ namespace Hellion
         vk::Pipeline pipeline;
         HDevice& device;
         std::vector<HShader> shaderLayout;
+        vk::PipelineBindPoint bindPoint = vk::PipelineBindPoint::eGraphics;
     public:
         HPipeline(HDevice& device, std::array<HShader, 2> shaderLayout, PipeConf configInfo) : device{device}
         {
@@ -33,15 +34,23 @@ namespace Hellion
             createGraphicsPipeline3(std::move(configInfo));
         }
 
+        HPipeline(HDevice& device, HShader computeShader, vk::PipelineLayout layout) : device{device}, bindPoint{vk::PipelineBindPoint::eCompute}
+        {
+            shaderLayout.push_back(std::move(computeShader));
+            createComputePipeline(layout);
+        }
+
         ~HPipeline()
         { device.getDevice().destroy(pipeline); }
 
         void bind(vk::CommandBuffer commandBuffer)
-        { commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline); }
+        { commandBuffer.bindPipeline(bindPoint, pipeline); }
 
         void createGraphicsPipeline(PipeConf conf);
 
         void createGraphicsPipeline3(PipeConf conf);
+
+        void createComputePipeline(vk::PipelineLayout layout);
     };
 }
 
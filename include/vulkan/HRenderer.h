@@ -10,6 +10,11 @@
 #include "HDevice.h"
 #include "HSwapChain.h"
 #include "ImGuiRender.h"
+#include "HFramePacer.h"
+#include "HGpuQueries.h"
+#include "../core/HFrameArena.h"
+#include "../core/HAllocationTracker.h"
+#include "../core/HProfiler.h"
 #include <tracy/TracyVulkan.hpp>
 
 namespace Hellion
@@ -29,8 +34,13 @@ namespace Hellion
         {
             for(auto& ctx: vkTracyContext)
                 TracyVkDestroy(ctx)
+            for(auto& ctx: vkTracyComputeContext)
+                TracyVkDestroy(ctx)
 
             freeCommandBuffers();
+            gpuQueries.destroy();
+            device.getDevice().destroy(computeTimeline);
+            device.getDevice().destroy(graphicsTimeline);
         }
 
         HRenderer(const HRenderer&) = delete;
@@ -61,43 +71,135 @@ namespace Hellion
             return vkTracyContext[currentFrameIndex];
         }
 
+        tracy::VkCtx* getCurrentComputeTracyCtx()
+        {
+            assert(isFrameStarted && "Cannot get command buffer when frame not in progress");
+            return vkTracyComputeContext[currentFrameIndex];
+        }
+
         int getFrameIndex() const
         {
             assert(isFrameStarted && "Cannot get frame index when frame not in progress");
             return currentFrameIndex;
         }
 
+        /// Transient CPU memory of the current frame, released when its frame slot begins again.
+        HFrameArena& getFrameArena()
+        {
+            assert(isFrameStarted && "Cannot get frame arena when frame not in progress");
+            return frameArenas[currentFrameIndex];
+        }
+
+
         vk::CommandBuffer beginFrame()
         {
             assert(!isFrameStarted && "Can't call beginFrame while already in progress");
+            framePacer.limit();
+            framePacer.waitForPresents(*swapChain);
+
             auto result = swapChain->acquireNextImage();
 
+            if(device.supportsPresentWait())
+                framePacer.collect(*swapChain);
+            else
+                framePacer.onFrameRetired();
+
             if(result.result == vk::Result::eErrorOutOfDateKHR)
             {
                 recreateSwapChain();
                 return nullptr;
             }
 
+            // the fence of this frame slot was waited on, retired swapchains older than the frames in flight are idle now
+            std::erase_if(retiredSwapChains, [this](const RetiredSwapChain& retired)
+            { return retired.retireFrame + HSwapChain::MAX_FRAMES_IN_FLIGHT <= frameCounter; });
+            frameArenas[currentFrameIndex].reset();
+            // frames are counted from beginFrame to beginFrame
+            HAllocationTracker::endFrame();
+            HProfiler::global().endFrame();
+
             currentImageIndex = result.value;
             isFrameStarted = true;
 
             auto commandBuffer = getCurrentCommandBuffer();
             vk::CommandBufferBeginInfo beginInfo{};
             commandBuffer.begin(beginInfo);
+            // the fence of this slot was waited on, so this also reads its results without stalling
+            gpuQueries.beginFrame(commandBuffer, currentFrameIndex, HProfiler::global().getFrame());
+
+            return commandBuffer;
+        }
+
+        /// Records work for the async compute queue. The graphics submission of this frame waits for it,
+        /// so culling results can be consumed by draws recorded in the same frame.
+        vk::CommandBuffer beginCompute()
+        {
+            assert(isFrameStarted && "Can't call beginCompute if frame is not in progress");
+            assert(!isComputeStarted && "Can't call beginCompute while already in progress");
+            isComputeStarted = true;
+
+            auto commandBuffer = computeCommandBuffers[currentFrameIndex];
+            vk::CommandBufferBeginInfo beginInfo{};
+            beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+            commandBuffer.begin(beginInfo);
 
             return commandBuffer;
         }
 
+        /// waitForGraphics makes the compute work wait for the previous frame's graphics submission,
+        /// which is what post-processing of the last rendered image needs.
+        void endCompute(bool waitForGraphics = false,
+                        vk::PipelineStageFlags consumerStage = vk::PipelineStageFlagBits::eDrawIndirect | vk::PipelineStageFlagBits::eVertexInput)
+        {
+            assert(isComputeStarted && "Can't call endCompute while compute is not in progress");
+            auto commandBuffer = computeCommandBuffers[currentFrameIndex];
+
+            TracyVkCollect(getCurrentComputeTracyCtx(), commandBuffer)
+
+            commandBuffer.end();
+
+            uint64_t signalValue = ++computeTimelineValue;
+            uint64_t waitValue = graphicsTimelineValue;
+            vk::PipelineStageFlags waitStage = vk::PipelineStageFlagBits::eComputeShader;
+
+            vk::TimelineSemaphoreSubmitInfo timelineInfo{};
+            timelineInfo.waitSemaphoreValueCount = waitForGraphics ? 1 : 0;
+            timelineInfo.pWaitSemaphoreValues = &waitValue;
+            timelineInfo.signalSemaphoreValueCount = 1;
+            timelineInfo.pSignalSemaphoreValues = &signalValue;
+
+            vk::SubmitInfo submitInfo{};
+            submitInfo.pNext = &timelineInfo;
+            submitInfo.waitSemaphoreCount = waitForGraphics ? 1 : 0;
+            submitInfo.pWaitSemaphores = &graphicsTimeline;
+            submitInfo.pWaitDstStageMask = &waitStage;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &commandBuffer;
+            submitInfo.signalSemaphoreCount = 1;
+            submitInfo.pSignalSemaphores = &computeTimeline;
+
+            device.getComputeQueue().submit(submitInfo);
+
+            computeWait = HTimelinePoint{computeTimeline, signalValue, consumerStage};
+            isComputeStarted = false;
+        }
+
         void endFrame()
         {
             assert(isFrameStarted && "Can't call endFrame while frame is not in progress");
+            assert(!isComputeStarted && "Can't call endFrame while compute is in progress");
             auto commandBuffer = getCurrentCommandBuffer();
 
             TracyVkCollect(getCurrentTracyCtx(), commandBuffer)
 
+            gpuQueries.endFrame(commandBuffer);
             commandBuffer.end();
 
-            auto result = swapChain->submitCommandBuffers(commandBuffer, currentImageIndex);
+            auto result = swapChain->submitCommandBuffers(commandBuffer, currentImageIndex, computeWait,
+                                                          HTimelinePoint{graphicsTimeline, ++graphicsTimelineValue});
+            computeWait.reset();
+            framePacer.onFrameSubmitted(swapChain->getLastPresentId(), presentPolicy);
+            frameCounter++;
 
             if(result == vk::Result::eErrorOutOfDateKHR || result == vk::Result::eSuboptimalKHR ||
                window.wasWindowResized())
@@ -150,6 +252,100 @@ namespace Hellion
             return render;
         }
 
+        HFramePacer& getFramePacer()
+        { return framePacer; }
+
+        /// Per pass GPU times and pipeline statistics, two frames behind the frame being recorded.
+        HGpuQueries& getGpuQueries()
+        { return gpuQueries; }
+
+        HPresentPolicy getPresentPolicy() const
+        { return presentPolicy; }
+
+        void setPresentPolicy(HPresentPolicy policy)
+        {
+            assert(!isFrameStarted && "Can't change the present policy while frame is in progress");
+            if(policy == presentPolicy)
+                return;
+            presentPolicy = policy;
+            recreateSwapChain();
+        }
+
+        void drawFramePacingUi()
+        {
+            ImGui::Begin("Frame pacing");
+
+            int policy = static_cast<int>(presentPolicy);
+            const char* policies[] = {toString(HPresentPolicy::Fifo), toString(HPresentPolicy::FifoRelaxed), toString(HPresentPolicy::Mailbox),
+                                      toString(HPresentPolicy::Immediate)};
+            if(ImGui::Combo("Present policy", &policy, policies, IM_ARRAYSIZE(policies)))
+                pendingPresentPolicy = static_cast<HPresentPolicy>(policy);
+            ImGui::Text("Present mode: %s", vk::to_string(swapChain->getPresentMode()).c_str());
+
+            float fps = static_cast<float>(framePacer.getTargetFps());
+            if(ImGui::SliderFloat("Fps limit (0 = off)", &fps, 0.0f, 360.0f, "%.0f"))
+                framePacer.setTargetFps(fps);
+
+            bool presentWait = framePacer.usesPresentWait();
+            ImGui::BeginDisabled(!device.supportsPresentWait());
+            if(ImGui::Checkbox("Present wait pacing", &presentWait))
+                framePacer.setPresentWait(presentWait);
+            ImGui::EndDisabled();
+
+            for(size_t i = 0; i < HFramePacer::POLICY_COUNT; i++)
+            {
+                auto& stats = framePacer.getStats(static_cast<HPresentPolicy>(i));
+                if(stats.samples > 0)
+                    ImGui::Text("%-12s avg %6.2f ms  min %6.2f ms  max %6.2f ms", policies[i], stats.averageMs(), stats.minMs, stats.maxMs);
+            }
+
+            size_t arenaPeak = 0;
+            size_t arenaCapacity = 0;
+            size_t arenaOverflows = 0;
+            for(const auto& arena: frameArenas)
+            {
+                arenaPeak = std::max(arenaPeak, arena.getPeak());
+                arenaCapacity = std::max(arenaCapacity, arena.getCapacity());
+                arenaOverflows += arena.getOverflowCount();
+            }
+            ImGui::Text("Frame arena: peak %.1f of %.1f KB, %zu overflows", arenaPeak / 1024.0, arenaCapacity / 1024.0, arenaOverflows);
+            if(HAllocationTracker::enabled())
+            {
+                const auto& last = HAllocationTracker::getLastFrame();
+                const auto& peak = HAllocationTracker::getPeakFrame();
+                ImGui::Text("Heap allocations last frame: %llu (%.1f KB), peak %llu", static_cast<unsigned long long>(last.allocations),
+                            last.bytes / 1024.0, static_cast<unsigned long long>(peak.allocations));
+                ImGui::Text("Device memory allocations last frame: %llu", static_cast<unsigned long long>(last.deviceAllocations));
+            }
+
+            if(gpuQueries.isSupported())
+            {
+                ImGui::Text("GPU frame: %.3f ms", gpuQueries.getFrameMs());
+                bool statistics = gpuQueries.usesPipelineStatistics();
+                ImGui::BeginDisabled(!gpuQueries.supportsPipelineStatistics());
+                if(ImGui::Checkbox("Pipeline statistics", &statistics))
+                    gpuQueries.setPipelineStatistics(statistics);
+                ImGui::EndDisabled();
+                for(const auto& pass: gpuQueries.getPasses())
+                {
+                    ImGui::Text("%-20s %7.3f ms  avg %7.3f ms  max %7.3f ms", pass.name, pass.lastMs, pass.averageMs(), pass.maxMs);
+                    if(statistics)
+                        ImGui::Text("    vertices %llu  primitives %llu  fragments %llu", static_cast<unsigned long long>(pass.vertexInvocations),
+                                    static_cast<unsigned long long>(pass.clippingPrimitives),
+                                    static_cast<unsigned long long>(pass.fragmentInvocations));
+                }
+            }
+            ImGui::End();
+        }
+
+        /// Applies changes made in the UI, must be called outside of a frame.
+        void applyPendingSettings()
+        {
+            if(pendingPresentPolicy)
+                setPresentPolicy(*pendingPresentPolicy);
+            pendingPresentPolicy.reset();
+        }
+
         void endSwapChainRenderPass(vk::CommandBuffer commandBuffer)
         {
             ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), commandBuffer);
@@ -164,6 +360,7 @@ namespace Hellion
         void freeCommandBuffers()
         {
             device.getDevice().freeCommandBuffers(device.getCommandPool(), commandBuffers);
+            device.getDevice().freeCommandBuffers(device.getComputeCommandPool(), computeCommandBuffers);
         }
 
         void recreateSwapChain()
@@ -174,33 +371,62 @@ namespace Hellion
                 extent = window.getExtent();
                 glfwWaitEvents();
             }
-            device.getDevice().waitIdle();
+            framePacer.dropPending();
 
             if(swapChain == nullptr)
             {
-                swapChain = std::make_unique<HSwapChain>(device, extent);
+                swapChain = std::make_unique<HSwapChain>(device, extent, presentPolicy);
             } else
             {
                 std::shared_ptr<HSwapChain> oldSwapChain = std::move(swapChain);
-                swapChain = std::make_unique<HSwapChain>(device, extent, oldSwapChain);
+                swapChain = std::make_unique<HSwapChain>(device, extent, oldSwapChain, presentPolicy);
 
                 if(!oldSwapChain->compareSwapFormats(*swapChain.get()))
                 {
                     throw std::runtime_error("Swap chain image(or depth) format has changed!");
                 }
+
+                // frames recorded against the old swapchain may still be executing, it is destroyed once they are done
+                retiredSwapChains.push_back({std::move(oldSwapChain), frameCounter});
             }
         }
+
+        struct RetiredSwapChain
+        {
+            std::shared_ptr<HSwapChain> swapChain;
+            uint64_t retireFrame;
+        };
+
         ImGuiRenderer render;
         HWindow& window;
         HDevice& device;
         std::unique_ptr<HSwapChain> swapChain;
+        std::vector<RetiredSwapChain> retiredSwapChains;
+        uint64_t frameCounter{0};
         std::vector<vk::CommandBuffer> commandBuffers;
+        std::vector<vk::CommandBuffer> computeCommandBuffers;
 
         std::vector<tracy::VkCtx*> vkTracyContext;
+        std::vector<tracy::VkCtx*> vkTracyComputeContext;
+
+        vk::Semaphore computeTimeline;
+        vk::Semaphore graphicsTimeline;
+        uint64_t computeTimelineValue{0};
+        uint64_t graphicsTimelineValue{0};
+        std::optional<HTimelinePoint> computeWait;
+
+        HFramePacer framePacer;
+        HPresentPolicy presentPolicy{HPresentPolicy::Mailbox};
+        std::optional<HPresentPolicy> pendingPresentPolicy;
+
+        std::array<HFrameArena, HSwapChain::MAX_FRAMES_IN_FLIGHT> frameArenas;
+
+        HGpuQueries gpuQueries;
 
         uint32_t currentImageIndex;
         int currentFrameIndex{0};
         bool isFrameStarted{false};
+        bool isComputeStarted{false};
     };
 
 } // Hellion
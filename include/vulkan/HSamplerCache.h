@@ -0,0 +1,49 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HSAMPLERCACHE_H
+#define HELLION_HSAMPLERCACHE_H
+
+#include <vulkan/vulkan.hpp>
+#include <mutex>
+#include <unordered_map>
+
+namespace Hellion
+{
+    /// Hands out one shared sampler per distinct create info, samplers are destroyed together with the cache.
+    class HSamplerCache
+    {
+    public:
+        HSamplerCache() = default;
+
+        HSamplerCache(const HSamplerCache&) = delete;
+
+        HSamplerCache& operator=(const HSamplerCache&) = delete;
+
+        /// The create info must not have a pNext chain, it is not part of the key.
+        vk::Sampler get(vk::Device device, const vk::SamplerCreateInfo& info);
+
+        void destroy(vk::Device device);
+
+        size_t size() const
+        { return samplers.size(); }
+
+    private:
+        struct Hash
+        {
+            size_t operator()(const vk::SamplerCreateInfo& info) const;
+        };
+
+        struct Equal
+        {
+            bool operator()(const vk::SamplerCreateInfo& a, const vk::SamplerCreateInfo& b) const;
+        };
+
+        std::unordered_map<vk::SamplerCreateInfo, vk::Sampler, Hash, Equal> samplers;
+        std::mutex mutex;
+    };
+
+} // Hellion
+
+#endif //HELLION_HSAMPLERCACHE_H
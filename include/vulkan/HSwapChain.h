@@ -13,6 +13,14 @@
 
 namespace Hellion
 {
+    enum class HPresentPolicy
+    {
+        Fifo,
+        FifoRelaxed,
+        Mailbox,
+        Immediate
+    };
+
     class HSwapChain
     {
     private:
@@ -41,16 +49,26 @@ namespace Hellion
         std::vector<vk::Semaphore> renderFinishedSemaphores;
         std::vector<vk::Fence> inFlightFences;
         size_t currentFrame = 0;
+
+        HPresentPolicy presentPolicy;
+        vk::PresentModeKHR presentMode;
+        uint64_t presentId = 0;
+        /// ids keep counting across recreation, the ones below this were presented on an older swapchain
+        uint64_t firstPresentId = 1;
     public:
         static constexpr int MAX_FRAMES_IN_FLIGHT = 2;
     public:
-        HSwapChain(HDevice& deviceRef, vk::Extent2D windowExtent) : device{deviceRef}, windowExtent{windowExtent}
+        HSwapChain(HDevice& deviceRef, vk::Extent2D windowExtent, HPresentPolicy policy = HPresentPolicy::Mailbox) : device{deviceRef},
+                                                                                                                    windowExtent{windowExtent},
+                                                                                                                    presentPolicy{policy}
         { init(); }
 
-        HSwapChain(HDevice& deviceRef, vk::Extent2D extent, std::shared_ptr<HSwapChain> previous) : device{deviceRef}, windowExtent{extent},
-                                                                                                    oldSwapChain{previous}
+        HSwapChain(HDevice& deviceRef, vk::Extent2D extent, std::shared_ptr<HSwapChain> previous, HPresentPolicy policy = HPresentPolicy::Mailbox)
+                : device{deviceRef}, windowExtent{extent}, oldSwapChain{previous}, presentPolicy{policy}, presentId{previous->presentId},
+                  firstPresentId{previous->presentId + 1}
         {
             init();
+            // the caller keeps the previous swapchain alive until its in-flight frames finished
             oldSwapChain = nullptr;
         }
 
@@ -84,12 +102,31 @@ namespace Hellion
         size_t imageCount()
         { return swapChainImages.size(); }
 
+        HPresentPolicy getPresentPolicy() const
+        { return presentPolicy; }
+
+        vk::PresentModeKHR getPresentMode() const
+        { return presentMode; }
+
+        /// Id attached to the last present through VK_KHR_present_id, 0 if nothing was presented yet.
+        uint64_t getLastPresentId() const
+        { return presentId; }
+
+        /// Id of the first present on this swapchain, only ids from here on can be waited on.
+        uint64_t getFirstPresentId() const
+        { return firstPresentId; }
+
+        /// Blocks until the present with the given id reached the display or the timeout expired.
+        /// Returns false on timeout or when VK_KHR_present_wait is not available.
+        bool waitForPresent(uint64_t id, uint64_t timeout);
+
         float extentAspectRatio()
         { return static_cast<float>(swapChainExtent.width) / static_cast<float>(swapChainExtent.height); }
 
         vk::ResultValue<uint32_t> acquireNextImage();
 
-        vk::Result submitCommandBuffers(const vk::CommandBuffer& commandBuffers, uint32_t imageIndex);
+        vk::Result submitCommandBuffers(const vk::CommandBuffer& commandBuffers, uint32_t imageIndex, std::optional<HTimelinePoint> wait = {},
+                                        std::optional<HTimelinePoint> signal = {});
 
         bool compareSwapFormats(const HSwapChain& swapChain) const
         {
@@ -118,6 +155,9 @@ namespace Hellion
 
         void createSyncObjects();
 
+        /// Takes over the render pass and the frame sync objects of the previous swapchain, only size dependent resources are recreated.
+        void adoptFromOldSwapChain();
+
         void init();
 
         void cleanup();
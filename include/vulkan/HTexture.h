@@ -8,11 +8,18 @@
 #include <vulkan/vulkan.hpp>
 #include "HDevice.h"
 #include "HBuffer.h"
+#include "../texture/HTextureCompressor.h"
+#include "../texture/HKtx2.h"
 #include <memory>
+#include <span>
+#include <algorithm>
+#include <cmath>
+#include <atomic>
 
 namespace Hellion
 {
-    class HTexture
+    /// Sampled textures can be moved by the device's defragmenter, attachments stay where they were allocated.
+    class HTexture : public HMovable
     {
     public:
         HTexture(HDevice& device, const std::string& textureFilepath) : device{device}
@@ -24,6 +31,32 @@ namespace Hellion
 
         }
 
+        /// Uploads the block compressed cache of the file, falling back to RGBA8 when the device can not sample the codec's format.
+        /// KTX2 files are already encoded and are uploaded as stored.
+        HTexture(HDevice& device, const std::string& textureFilepath, HTextureCodec codec) : device{device}
+        {
+            bool compress = codec != HTextureCodec::Rgba8 && !HKtx2Texture::isKtx2(textureFilepath);
+            if(compress && device.supportsSampledFormat(HTextureCompressor::vulkanFormat(codec)))
+                createCompressedTextureImage(textureFilepath, codec);
+            else
+            {
+                if(compress)
+                    fmt::println("compressed format is not supported, {} is uploaded uncompressed", textureFilepath);
+                createTextureImage(textureFilepath);
+            }
+            createTextureImageView(vk::ImageViewType::e2D);
+            createTextureSampler();
+            updateDescriptor();
+        }
+
+        /// Uploads an RGBA8 image from memory with its first mipLevels levels, e.g. an atlas page.
+        HTexture(HDevice& device, const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t mipLevels);
+
+        /// Creates the image and records the copy of every level from stagingBuffer into commandBuffer.
+        /// The texture can be sampled once the command buffer has executed, the caller keeps the staging buffer alive until then.
+        HTexture(HDevice& device, vk::Format format, vk::Extent3D extent, uint32_t mipLevels, vk::CommandBuffer commandBuffer, vk::Buffer stagingBuffer,
+                 std::span<const vk::BufferImageCopy> regions);
+
         HTexture(HDevice& device, vk::Format format, vk::Extent3D extent, vk::ImageUsageFlags usage, vk::SampleCountFlagBits sampleCount) : device{device}
         {
             vk::ImageAspectFlags aspectMask;
@@ -72,7 +105,7 @@ namespace Hellion
 
             if(usage & vk::ImageUsageFlagBits::eSampled)
             {
-                auto properties = device.getPhysicalDevice().getProperties();
+                const auto& properties = device.getProperties();
                 vk::SamplerCreateInfo samplerInfo{};
                 samplerInfo.magFilter = vk::Filter::eLinear;
                 samplerInfo.minFilter = vk::Filter::eLinear;
@@ -90,7 +123,7 @@ namespace Hellion
                 samplerInfo.minLod = 0.0f;
                 samplerInfo.maxLod = static_cast<float>(mipLevels);
 
-                textureSampler = device.getDevice().createSampler(samplerInfo);
+                textureSampler = device.getSampler(samplerInfo);
 
                 vk::ImageLayout samplerImageLayout = imageLayout == vk::ImageLayout::eColorAttachmentOptimal
                                                    ? vk::ImageLayout::eShaderReadOnlyOptimal
@@ -101,11 +134,30 @@ namespace Hellion
             }
         }
 
-        ~HTexture()
+        ~HTexture() override
         {
-            device.getDevice().destroy(textureSampler);
+            // the sampler is shared through the device's cache
+            auto& defragmenter = device.getDefragmenter();
+            if(defragmenter.release(imageAllocation))
+            {
+                device.releaseAllocation(imageAllocation);
+                // the pass's copy reads the old image and writes the new one until its fence signals
+                defragmenter.retire(textureImageView);
+                defragmenter.retire(textureImage);
+                if(movedImage)
+                {
+                    defragmenter.retire(movedImageView);
+                    defragmenter.retire(movedImage);
+                }
+                return;
+            }
             device.getDevice().destroy(textureImageView);
-            vmaDestroyImage(device.getAllocator(), textureImage, imageAllocation);
+            if(movedImage)
+            {
+                device.getDevice().destroy(movedImageView);
+                device.getDevice().destroyImage(movedImage);
+            }
+            device.destroyImage(textureImage, imageAllocation);
         }
 
         HTexture(const HTexture&) = delete;
@@ -136,6 +188,14 @@ namespace Hellion
         vk::Format getFormat() const
         { return format; }
 
+        /// Unique among all textures and changes whenever the image or view is replaced, descriptors compare it to know when to rewrite.
+        uint32_t getRevision() const
+        { return revision; }
+
+        void recordMove(vk::CommandBuffer commandBuffer, VmaAllocation allocation) override;
+
+        void finishMove() override;
+
         void updateDescriptor()
         {
             descriptor.sampler = textureSampler;
@@ -148,15 +208,39 @@ namespace Hellion
             return std::make_unique<HTexture>(device, filepath);
         }
 
+        static std::unique_ptr<HTexture> createTextureFromFile(HDevice& device, const std::string& filepath, HTextureCodec codec)
+        {
+            return std::make_unique<HTexture>(device, filepath, codec);
+        }
+
+        /// Full chain down to 1x1.
+        static uint32_t mipLevelCount(uint32_t width, uint32_t height)
+        {
+            return static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+        }
+
     private:
         void createTextureImage(const std::string& filepath);
 
+        void createCompressedTextureImage(const std::string& filepath, HTextureCodec codec);
+
+        /// Maps the container and copies its levels without decoding, block compressed formats stay compressed.
+        void createKtx2TextureImage(const std::string& filepath);
+
+        /// Creates the image from tightly described levels in a single staging buffer and copy.
+        void uploadLevels(std::span<const std::byte> data, std::span<const vk::BufferImageCopy> regions, bool blitMips);
+
+        /// Sampled images also get eTransferSrc and are tracked by the defragmenter.
+        void createImage(vk::ImageUsageFlags usage);
+
+        vk::ImageCreateInfo imageCreateInfo() const;
+
         void createTextureImageView(vk::ImageViewType viewType)
         {
             vk::ImageViewCreateInfo viewInfo{};
             viewInfo.image = textureImage;
             viewInfo.viewType = viewType;
-            viewInfo.format = vk::Format::eR8G8B8A8Srgb;
+            viewInfo.format = format;
             viewInfo.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
             viewInfo.subresourceRange.baseMipLevel = 0;
             viewInfo.subresourceRange.levelCount = mipLevels;
@@ -168,7 +252,7 @@ namespace Hellion
 
         void createTextureSampler()
         {
-            auto properties = device.getPhysicalDevice().getProperties();
+            const auto& properties = device.getProperties();
 
             vk::SamplerCreateInfo samplerInfo{};
             samplerInfo.magFilter = vk::Filter::eLinear;
@@ -187,7 +271,7 @@ namespace Hellion
             samplerInfo.minLod = 0.0f;
             samplerInfo.maxLod = static_cast<float>(mipLevels);
 
-            textureSampler = device.getDevice().createSampler(samplerInfo);
+            textureSampler = device.getSampler(samplerInfo);
         }
 
         vk::DescriptorImageInfo descriptor{};
@@ -202,6 +286,13 @@ namespace Hellion
         uint32_t mipLevels{1};
         uint32_t layerCount{1};
         vk::Extent3D extent{};
+        vk::ImageUsageFlags imageUsage;
+        /// the image and view before a move, kept until the defragmenter's copy has executed
+        vk::Image movedImage = nullptr;
+        vk::ImageView movedImageView = nullptr;
+
+        static inline std::atomic<uint32_t> nextRevision{1};
+        uint32_t revision = nextRevision++;
     };
 }
 
@@ -0,0 +1,197 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#ifndef HELLION_HTEXTURESTREAMER_H
+#define HELLION_HTEXTURESTREAMER_H
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include "HDevice.h"
+#include "HBuffer.h"
+#include "HTexture.h"
+#include "../texture/HTextureCompressor.h"
+
+namespace Hellion
+{
+    struct HTextureHandle
+    {
+        uint32_t index = UINT32_MAX;
+
+        bool isValid() const
+        { return index != UINT32_MAX; }
+    };
+
+    struct HTextureStreamingStats
+    {
+        vk::DeviceSize budgetBytes = 0;
+        vk::DeviceSize residentBytes = 0;
+        /// what the requests would need if the budget was unlimited
+        vk::DeviceSize requestedBytes = 0;
+        uint32_t textureCount = 0;
+        uint32_t residentLevels = 0;
+        uint32_t requestedLevels = 0;
+        uint32_t pendingTextures = 0;
+        uint64_t loadedLevels = 0;
+        uint64_t evictedLevels = 0;
+    };
+
+    /// Loads textures without blocking the caller. A handle samples a 1x1 white placeholder until its file has been decoded
+    /// on the thread pool and uploaded; uploads are started from update() with at most uploadBudget bytes per frame.
+    ///
+    /// Every texture keeps its decoded levels in system memory and only the levels requested by the renderer are resident.
+    /// When the requests do not fit into the memory budget, the largest resident levels are dropped first.
+    class HTextureStreamer
+    {
+    public:
+        static constexpr float DEFAULT_UPLOAD_BUDGET_MB = 32.0f;
+        static constexpr float DEFAULT_MEMORY_BUDGET_MB = 512.0f;
+        /// levels this large or smaller are always resident
+        static constexpr uint32_t MIN_RESIDENT_SIZE = 64;
+        /// updates without a request after which a texture falls back to its smallest levels
+        static constexpr uint64_t REQUEST_TIMEOUT = 120;
+
+        explicit HTextureStreamer(HDevice& device, float uploadBudgetMB = DEFAULT_UPLOAD_BUDGET_MB, float memoryBudgetMB = DEFAULT_MEMORY_BUDGET_MB);
+
+        ~HTextureStreamer();
+
+        HTextureStreamer(const HTextureStreamer&) = delete;
+
+        HTextureStreamer& operator=(const HTextureStreamer&) = delete;
+
+        /// Starts decoding on the thread pool, KTX2 files are uploaded as stored and ignore the codec.
+        HTextureHandle load(const std::string& path, HTextureCodec codec = HTextureCodec::Rgba8);
+
+        /// Requests the finest level needed this frame, the finest request between two updates wins.
+        void requestMip(HTextureHandle handle, uint32_t mip);
+
+        /// Requests the level whose largest dimension matches screenPixels, i.e. about one texel per pixel.
+        void requestScreenSize(HTextureHandle handle, float screenPixels);
+
+        /// Called once per frame on the render thread: swaps in finished uploads, fits the requests into the memory budget
+        /// and starts new uploads within the upload budget.
+        void update(std::pmr::memory_resource& frameMemory);
+
+        /// The placeholder until the texture is resident.
+        vk::DescriptorImageInfo getImageInfo(HTextureHandle handle) const;
+
+        /// Changes every time the image behind the handle changes, including defragmentation moves,
+        /// descriptor sets compare it to know when to be rewritten.
+        uint32_t getVersion(HTextureHandle handle) const
+        {
+            const auto& entry = entries[handle.index];
+            return entry.texture ? entry.texture->getRevision() : placeholder->getRevision();
+        }
+
+        bool isResident(HTextureHandle handle) const
+        { return entries[handle.index].texture != nullptr; }
+
+        const HTextureStreamingStats& getStats() const
+        { return stats; }
+
+        void setUploadBudget(float megabytes)
+        { uploadBudget = static_cast<vk::DeviceSize>(megabytes * 1024.0f * 1024.0f); }
+
+        /// The effective budget is also capped by what VMA reports as available on the device local heaps.
+        void setMemoryBudget(float megabytes)
+        { memoryBudget = static_cast<vk::DeviceSize>(megabytes * 1024.0f * 1024.0f); }
+
+        /// Asks the next update to shrink the resident chains by at least bytes, e.g. when the device is close to its memory budget.
+        void evict(vk::DeviceSize bytes)
+        { pendingEviction = std::max(pendingEviction, bytes); }
+
+        void drawStatsUi();
+
+    private:
+        /// Every level of the source file, ready to be copied as is. Level offsets are relative to the start of bytes.
+        struct DecodedTexture
+        {
+            vk::Format format = vk::Format::eR8G8B8A8Srgb;
+            std::vector<HTextureLevel> levels;
+            std::vector<std::byte> bytes;
+        };
+
+        enum class State
+        {
+            Decoding,
+            Streaming,
+            Failed
+        };
+
+        struct Entry
+        {
+            std::string path;
+            State state = State::Decoding;
+            std::future<DecodedTexture> decoded;
+            DecodedTexture source;
+            std::unique_ptr<HTexture> texture;
+            /// level 0 of the image is this level of the source, levelCount() while nothing is resident
+            uint32_t residentMip = 0;
+            uint32_t requestedMip = UINT32_MAX;
+            uint64_t lastRequest = 0;
+            uint32_t targetMip = 0;
+            bool uploading = false;
+
+            uint32_t levelCount() const
+            { return static_cast<uint32_t>(source.levels.size()); }
+
+            /// first level that is not larger than MIN_RESIDENT_SIZE
+            uint32_t tailMip() const;
+
+            vk::DeviceSize chainSize(uint32_t firstMip) const;
+        };
+
+        struct PendingTexture
+        {
+            uint32_t index;
+            uint32_t firstMip;
+            std::unique_ptr<HTexture> texture;
+        };
+
+        /// One submission with every texture started in the same frame, its staging buffer lives until the fence signals.
+        struct Upload
+        {
+            vk::CommandBuffer commandBuffer;
+            vk::Fence fence;
+            std::unique_ptr<HBuffer> staging;
+            std::vector<PendingTexture> textures;
+        };
+
+        /// Replaced image that frames in flight may still sample.
+        struct RetiredTexture
+        {
+            uint64_t frame;
+            std::unique_ptr<HTexture> texture;
+        };
+
+        static DecodedTexture decode(const std::string& path, HTextureCodec codec);
+
+        void createPlaceholder();
+
+        void retireUploads(bool wait);
+
+        void collectDecoded();
+
+        void computeTargets();
+
+        void startUploads(std::pmr::memory_resource& frameMemory);
+
+        HDevice& device;
+        std::unique_ptr<HTexture> placeholder;
+        std::vector<Entry> entries;
+        std::vector<Upload> uploads;
+        std::vector<RetiredTexture> retired;
+        vk::DeviceSize uploadBudget;
+        vk::DeviceSize memoryBudget;
+        vk::DeviceSize pendingEviction = 0;
+        uint64_t frame = 0;
+        HTextureStreamingStats stats;
+    };
+
+} // Hellion
+
+#endif //HELLION_HTEXTURESTREAMER_H
@@ -94,6 +94,93 @@ namespace Hellion
             return pos == other.pos && color == other.color;
         }
     };
+
+    enum class HUvFormat
+    {
+        Half,
+        Unorm16
+    };
+
+    /// Binding and attribute descriptions shared by the packed layouts.
+    /// Locations match the full layout where they overlap: 0 position, 1 color, 2 texCoord, 3 normal.
+    template<class Vertex, HUvFormat Uv, bool HasColor>
+    struct HPackedVertexLayout
+    {
+        static constexpr HUvFormat UV_FORMAT = Uv;
+        static constexpr bool HAS_COLOR = HasColor;
+
+        static vk::VertexInputBindingDescription getBindingDescriptions()
+        {
+            vk::VertexInputBindingDescription bindingDescription = {};
+            bindingDescription.binding = 0;
+            bindingDescription.stride = sizeof(Vertex);
+            bindingDescription.inputRate = vk::VertexInputRate::eVertex;
+
+            return bindingDescription;
+        }
+
+        static std::array<vk::VertexInputAttributeDescription, HasColor ? 4 : 3> getAttributeDescriptions()
+        {
+            std::array<vk::VertexInputAttributeDescription, HasColor ? 4 : 3> attributeDescriptions{};
+
+            attributeDescriptions[0].binding = 0;
+            attributeDescriptions[0].location = 0;
+            attributeDescriptions[0].format = vk::Format::eR16G16B16A16Unorm;
+            attributeDescriptions[0].offset = offsetof(Vertex, position);
+
+            attributeDescriptions[1].binding = 0;
+            attributeDescriptions[1].location = 2;
+            attributeDescriptions[1].format = Uv == HUvFormat::Half ? vk::Format::eR16G16Sfloat : vk::Format::eR16G16Unorm;
+            attributeDescriptions[1].offset = offsetof(Vertex, texCoord);
+
+            attributeDescriptions[2].binding = 0;
+            attributeDescriptions[2].location = 3;
+            attributeDescriptions[2].format = vk::Format::eR16G16Snorm;
+            attributeDescriptions[2].offset = offsetof(Vertex, normal);
+
+            if constexpr(HasColor)
+            {
+                attributeDescriptions[3].binding = 0;
+                attributeDescriptions[3].location = 1;
+                attributeDescriptions[3].format = vk::Format::eR8G8B8A8Unorm;
+                attributeDescriptions[3].offset = offsetof(Vertex, color);
+            }
+
+            return attributeDescriptions;
+        }
+    };
+
+    /// 16 byte vertex: position quantized to the mesh bounds, octahedral normal, half or unorm16 uv.
+    /// The position is dequantized by the model matrix, see HQuantization.
+    template<HUvFormat Uv = HUvFormat::Half, bool HasColor = false>
+    struct HVertexPacked : HPackedVertexLayout<HVertexPacked<Uv, HasColor>, Uv, HasColor>
+    {
+        uint16_t position[4];
+        int16_t normal[2];
+        uint16_t texCoord[2];
+    };
+
+    /// 20 byte variant with an rgba8 color.
+    template<HUvFormat Uv>
+    struct HVertexPacked<Uv, true> : HPackedVertexLayout<HVertexPacked<Uv, true>, Uv, true>
+    {
+        uint16_t position[4];
+        int16_t normal[2];
+        uint16_t texCoord[2];
+        uint8_t color[4];
+    };
+
+    static_assert(sizeof(HVertexPacked<HUvFormat::Half, false>) == 16);
+    static_assert(sizeof(HVertexPacked<HUvFormat::Half, true>) == 20);
+
+    enum class HVertexFormat : uint32_t
+    {
+        Full,
+        PackedHalfUv,
+        PackedUnormUv,
+        PackedHalfUvColor,
+        PackedUnormUvColor
+    };
 } // Hellion
 
 namespace std
@@ -9,8 +9,13 @@
 #include "HPipeline.h"
 #include "HDescriptorSetLayout.h"
 #include "HBuffer.h"
-#include "tiny_obj_loader.h"
 #include "HTexture.h"
+#include "HMeshletCuller.h"
+#include "HGeometryArena.h"
+#include "HTextureStreamer.h"
+#include "../mesh/HMeshCache.h"
+#include "../mesh/HObjImporter.h"
+#include "../mesh/HMeshProcessor.h"
 #include <chrono>
 #include <tracy/TracyVulkan.hpp>
 #include "../core/Profiling.h"
@@ -21,18 +26,23 @@ namespace Hellion
     class RenderSystem
     {
     public:
-        RenderSystem(HDevice& device, vk::RenderPass renderPass, HSwapChain& swapchain)
-                : device{device}
+        /// modelFormat is a request, the mesh cache falls back to half uvs when the model's uvs don't fit unorm16.
+        RenderSystem(HDevice& device, HGeometryArena& geometry, HTextureStreamer& textures, vk::RenderPass renderPass, HSwapChain& swapchain,
+                     HVertexFormat modelFormat = HVertexFormat::PackedUnormUv)
+                : device{device}, textures{textures}, geometry{geometry}, modelFormat{modelFormat}
         {
             createPipelineLayout();
-            createPipeline(renderPass, swapchain);
             loadModel();
-            createVertexBufferVma();
-            createIndexBufferVma();
+            createPipeline(renderPass, swapchain);
+            uploadGeometry();
+            createMeshletCuller();
+            // the buffers are uploaded, the mapping is not needed anymore
+            mesh.reset();
         }
 
         ~RenderSystem()
         {
+            geometry.release(geometryHandle);
             device.getDevice().destroy(pipelineLayout);
         }
 
@@ -42,24 +52,76 @@ namespace Hellion
 
         void draw(vk::CommandBuffer& buffer, uint32_t currentFrame, tracy::VkCtx* tracyCtx);
 
-        void updateBuffers(uint32_t currentFrame, float width, float height, HCamera camera)
+        /// Records meshlet culling on the async compute command buffer, must follow updateBuffers of the same frame.
+        void cull(vk::CommandBuffer computeBuffer, uint32_t currentFrame, tracy::VkCtx* tracyCtx);
+
+        /// frameMemory is for data that is gone by the end of the frame, e.g. the renderer's frame arena.
+        void updateBuffers(uint32_t currentFrame, float width, float height, HCamera camera, std::pmr::memory_resource& frameMemory)
         {
             HELLION_ZONE_PROFILING()
+            updateTextureDescriptor(currentFrame, frameMemory);
             static auto startTime = std::chrono::high_resolution_clock::now();
 
             auto currentTime = std::chrono::high_resolution_clock::now();
             float time = std::chrono::duration<float, std::chrono::seconds::period>(currentTime - startTime).count();
 
+            glm::mat4 model = glm::rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+            float pixelsPerUnit = projectedPixelsPerUnit(model, height, camera);
+            selectLod(pixelsPerUnit);
+            // the texture is assumed to span the model once, its diameter on screen is the resolution that is needed
+            textures.requestScreenSize(textureHandle, 2.0f * bounds.radius() * pixelsPerUnit);
+
             UniformBufferObject ubo{};
-            ubo.model = glm::rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+            ubo.model = model * quantization.matrix();
             ubo.view = camera.getViewMatrix();//glm::lookAt(glm::vec3(2.0f, 2.0f, 2.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
             ubo.proj = camera.getProjectionMatrix();//glm::perspective(glm::radians(45.0f), width / (float) height, 0.1f, 10.0f);
             ubo.proj[1][1] *= -1;
+
+            // meshlet bounds are in mesh units, culling uses the model matrix without the dequantization
+            cullModel = model;
+            cullViewProj = ubo.proj * ubo.view;
+            cullCameraPosition = camera.getPosition();
             ubo.time = time * 15;
             memcpy(uboBuffers[currentFrame]->getMappedMemory(), &ubo, sizeof(ubo));
         }
 
+        const HMeshLod& getCurrentLod() const
+        { return lods[currentLod]; }
+
     private:
+        /// The set of this frame is no longer in use once its frame began, a texture that finished streaming is swapped in here.
+        void updateTextureDescriptor(uint32_t currentFrame, std::pmr::memory_resource& frameMemory)
+        {
+            auto version = textures.getVersion(textureHandle);
+            if(descriptorTextureVersions[currentFrame] == version)
+                return;
+            auto imageInfo = textures.getImageInfo(textureHandle);
+            HDescriptorWriter(*renderSystemLayout, *globalPool, &frameMemory)
+                    .writeImage(1, &imageInfo)
+                    .overwrite(globalDescriptorSets[currentFrame]);
+            descriptorTextureVersions[currentFrame] = version;
+        }
+
+        /// largest simplification error in pixels that is accepted when choosing a coarser LOD
+        static constexpr float LOD_PIXEL_ERROR = 1.0f;
+
+        /// Screen pixels covered by one mesh unit at the distance of the nearest point of the bounding sphere.
+        float projectedPixelsPerUnit(const glm::mat4& model, float viewportHeight, const HCamera& camera) const
+        {
+            glm::vec3 center = glm::vec3(model * glm::vec4(bounds.center(), 1.0f));
+            float distance = std::max(glm::length(center - camera.getPosition()) - bounds.radius(), 0.1f);
+            return viewportHeight / (2.0f * distance * std::tan(glm::radians(camera.getFov()) * 0.5f));
+        }
+
+        /// Picks the coarsest LOD whose projected error stays under LOD_PIXEL_ERROR.
+        void selectLod(float pixelsPerUnit)
+        {
+            currentLod = 0;
+            for(uint32_t i = 1; i < lods.size(); i++)
+                if(lods[i].error * pixelsPerUnit <= LOD_PIXEL_ERROR)
+                    currentLod = i;
+        }
+
         struct UniformBufferObject
         {
             alignas(16) glm::mat4 model;
@@ -68,36 +130,16 @@ namespace Hellion
             alignas(16) float time;
         };
 
-        void createVertexBufferVma()
+        void uploadGeometry()
         {
             HELLION_ZONE_PROFILING()
-            vk::DeviceSize bufferSize = sizeof(vertices[0]) * vertices.size();
-            auto stagingBuffer = HBuffer(device, bufferSize, vk::BufferUsageFlagBits::eTransferSrc, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
-                                                                                                    VMA_ALLOCATION_CREATE_MAPPED_BIT);
-
-            memcpy(stagingBuffer.getMappedMemory(), vertices.data(), (size_t) bufferSize);
-            vertexBuffer = std::make_unique<HBuffer>(device, bufferSize, vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eVertexBuffer, 0);
-
-            device.copyBuffer(stagingBuffer.getBuffer(), vertexBuffer->getBuffer(), bufferSize);
-        }
-
-        void createIndexBufferVma()
-        {
-            HELLION_ZONE_PROFILING()
-            vk::DeviceSize bufferSize = sizeof(indices[0]) * indices.size();
-            auto stagingBuffer = HBuffer(device, bufferSize, vk::BufferUsageFlagBits::eTransferSrc, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
-                                                                                                    VMA_ALLOCATION_CREATE_MAPPED_BIT);
-
-            memcpy(stagingBuffer.getMappedMemory(), indices.data(), (size_t) bufferSize);
-            indexBuffer = std::make_unique<HBuffer>(device, bufferSize, vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eIndexBuffer, 0);
-
-            device.copyBuffer(stagingBuffer.getBuffer(), indexBuffer->getBuffer(), bufferSize);
+            geometryHandle = geometry.upload(mesh->vertexBytes(), mesh->header().vertexStride, mesh->indices());
         }
 
         void createPipelineLayout()
         {
             HELLION_ZONE_PROFILING()
-            texture = HTexture::createTextureFromFile(device, TEXTURE_PATH.c_str());
+            textureHandle = textures.load(TEXTURE_PATH, HTextureCodec::BC1);
 
             globalPool =
                     HDescriptorPool::Builder(device)
@@ -125,9 +167,10 @@ namespace Hellion
                             .build();
 
             globalDescriptorSets.resize(HSwapChain::MAX_FRAMES_IN_FLIGHT);
+            descriptorTextureVersions.assign(HSwapChain::MAX_FRAMES_IN_FLIGHT, textures.getVersion(textureHandle));
             for(int i = 0; i < globalDescriptorSets.size(); i++)
             {
-                auto imageInfo = texture->getImageInfo();
+                auto imageInfo = textures.getImageInfo(textureHandle);
                 auto bufferInfo = uboBuffers[i]->descriptorInfo();
                 HDescriptorWriter(*renderSystemLayout, *globalPool)
                         .writeBuffer(0, &bufferInfo)
@@ -149,56 +192,43 @@ namespace Hellion
             PipeConf pipelineConfig = PipeConf::createDefault2(swapchain);
             pipelineConfig.renderPass = renderPass;
             pipelineConfig.pipelineLayout = pipelineLayout;
-            pipeline = std::make_unique<HPipeline>(device, std::array<HShader, 2>{HShader("../Data/Shaders/vert.spv"), HShader("../Data/Shaders/frag.spv")},
+            // the mesh may have been stored with half uvs instead of the requested unorm16, see HVertexEncoding::resolve
+            auto vertexFormat = mesh->vertexFormat();
+            pipelineConfig.bindingDescriptions = HVertexEncoding::bindingDescription(vertexFormat);
+            pipelineConfig.attributeDescriptions = HVertexEncoding::attributeDescriptions(vertexFormat);
+            auto vertexShader = vertexFormat == HVertexFormat::Full ? "../Data/Shaders/vert.spv" : "../Data/Shaders/vertPacked.spv";
+            pipeline = std::make_unique<HPipeline>(device, std::array<HShader, 2>{HShader(vertexShader), HShader("../Data/Shaders/frag.spv")},
                                                    std::move(pipelineConfig));
         }
 
+        void createMeshletCuller()
+        {
+            HELLION_ZONE_PROFILING()
+            auto meshlets = mesh->meshlets();
+            if(meshlets.empty())
+                return;
+            meshletCuller = std::make_unique<HMeshletCuller>(device, meshlets);
+        }
+
+        bool useMeshletCulling() const
+        { return meshletCuller && currentLod == 0; }
+
         const std::string TEXTURE_PATH = "../Data/Textures/viking_room.png";
         const std::string MODEL_PATH = "../Data/Models/viking_room.obj";
 
         void loadModel()
         {
             HELLION_ZONE_PROFILING()
-            tinyobj::attrib_t attrib;
-            std::vector<tinyobj::shape_t> shapes;
-            std::vector<tinyobj::material_t> materials;
-            std::string warn, err;
-
-            if(!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, MODEL_PATH.c_str()))
-            {
-                throw std::runtime_error(warn + err);
-            }
-
-            std::unordered_map<HVertex, uint32_t> uniqueVertices{};
-
-            for(const auto& shape: shapes)
+            mesh = HMeshCache::loadOrImport(MODEL_PATH, [](const std::string& path)
             {
-                for(const auto& index: shape.mesh.indices)
-                {
-                    HVertex vertex{};
-
-                    vertex.pos = {
-                            attrib.vertices[3 * index.vertex_index + 0],
-                            attrib.vertices[3 * index.vertex_index + 1],
-                            attrib.vertices[3 * index.vertex_index + 2]
-                    };
-
-                    vertex.texCoord = {
-                            attrib.texcoords[2 * index.texcoord_index + 0],
-                            1.0f - attrib.texcoords[2 * index.texcoord_index + 1]
-                    };
-
-                    vertex.color = {1.0f, 1.0f, 1.0f};
-
-                    if(uniqueVertices.count(vertex) == 0)
-                    {
-                        uniqueVertices[vertex] = static_cast<uint32_t>(vertices.size());
-                        vertices.push_back(vertex);
-                    }
-
-                    indices.push_back(uniqueVertices[vertex]);
-                }
-            }
+                auto data = HObjImporter::import(path);
+                HMeshProcessor::process(data);
+                return data;
+            }, modelFormat);
+            bounds = mesh->bounds();
+            quantization = mesh->quantization();
+            auto meshLods = mesh->lods();
+            lods.assign(meshLods.begin(), meshLods.end());
         }
 
         HDevice& device;
@@ -206,14 +236,24 @@ namespace Hellion
         vk::PipelineLayout pipelineLayout;
         std::unique_ptr<HDescriptorPool> globalPool;
 
-        std::unique_ptr<HTexture> texture;
+        HTextureStreamer& textures;
+        HTextureHandle textureHandle;
+        std::vector<uint32_t> descriptorTextureVersions;
 
         std::vector<std::unique_ptr<HBuffer>> uboBuffers;
 
-        std::vector<HVertex> vertices;
-        std::vector<uint32_t> indices;
-        std::unique_ptr<HBuffer> vertexBuffer;
-        std::unique_ptr<HBuffer> indexBuffer;
+        std::optional<HMappedMesh> mesh;
+        std::vector<HMeshLod> lods;
+        uint32_t currentLod = 0;
+        std::unique_ptr<HMeshletCuller> meshletCuller;
+        glm::mat4 cullModel{1.0f};
+        glm::mat4 cullViewProj{1.0f};
+        glm::vec3 cullCameraPosition{0.0f};
+        HBounds bounds;
+        HQuantization quantization;
+        HGeometryArena& geometry;
+        HGeometryHandle geometryHandle;
+        HVertexFormat modelFormat;
         std::vector<vk::DescriptorSet> globalDescriptorSets;
         std::unique_ptr<HDescriptorSetLayout> renderSystemLayout;
     };
@@ -0,0 +1,245 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/core/HAllocationTracker.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <fmt/core.h>
+#include <tracy/Tracy.hpp>
+
+namespace
+{
+    std::atomic<uint64_t> allocationCount{0};
+    std::atomic<uint64_t> allocationBytes{0};
+    std::atomic<uint64_t> deviceAllocationCount{0};
+    std::atomic<uint64_t> deviceAllocationBytes{0};
+    std::atomic<Hellion::HAllocationScopeStats*> scopes{nullptr};
+    thread_local Hellion::HAllocationScopeStats* currentScope = nullptr;
+
+    Hellion::HAllocationCounts frameStart;
+    Hellion::HAllocationCounts lastFrame;
+    Hellion::HAllocationCounts peakFrame;
+    Hellion::HAllocationCounts frameTotal;
+    uint64_t frames = 0;
+    bool frameStarted = false;
+
+    Hellion::HAllocationCounts now()
+    {
+        return Hellion::HAllocationCounts{allocationCount.load(std::memory_order_relaxed), allocationBytes.load(std::memory_order_relaxed),
+                                          deviceAllocationCount.load(std::memory_order_relaxed),
+                                          deviceAllocationBytes.load(std::memory_order_relaxed)};
+    }
+}
+
+#ifdef HELLION_TRACK_ALLOCATIONS
+
+namespace
+{
+    void record(void* pointer, std::size_t size)
+    {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocationBytes.fetch_add(size, std::memory_order_relaxed);
+        if(auto scope = currentScope)
+        {
+            scope->allocations.fetch_add(1, std::memory_order_relaxed);
+            scope->bytes.fetch_add(size, std::memory_order_relaxed);
+        }
+#ifdef HELLION_PROFILING
+        TracyAlloc(pointer, size);
+#endif
+    }
+
+    void release(void* pointer)
+    {
+#ifdef HELLION_PROFILING
+        if(pointer)
+            TracyFree(pointer);
+#endif
+    }
+
+    void* allocate(std::size_t size)
+    {
+        if(void* pointer = std::malloc(size == 0 ? 1 : size))
+        {
+            record(pointer, size);
+            return pointer;
+        }
+        throw std::bad_alloc();
+    }
+
+    void* allocateAligned(std::size_t size, std::align_val_t alignment)
+    {
+        auto align = static_cast<std::size_t>(alignment);
+#ifdef _MSC_VER
+        void* pointer = _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+        // aligned_alloc wants a multiple of the alignment
+        void* pointer = std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align);
+#endif
+        if(!pointer)
+            throw std::bad_alloc();
+        record(pointer, size);
+        return pointer;
+    }
+
+    void freeAligned(void* pointer)
+    {
+        release(pointer);
+#ifdef _MSC_VER
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+
+    void VKAPI_PTR onDeviceAllocate(VmaAllocator, uint32_t, VkDeviceMemory memory, VkDeviceSize size, void*)
+    {
+        deviceAllocationCount.fetch_add(1, std::memory_order_relaxed);
+        deviceAllocationBytes.fetch_add(size, std::memory_order_relaxed);
+#ifdef HELLION_PROFILING
+        TracyAllocN(reinterpret_cast<void*>(memory), size, "Device memory");
+#endif
+    }
+
+    void VKAPI_PTR onDeviceFree(VmaAllocator, uint32_t, VkDeviceMemory memory, VkDeviceSize, void*)
+    {
+#ifdef HELLION_PROFILING
+        TracyFreeN(reinterpret_cast<void*>(memory), "Device memory");
+#endif
+    }
+
+    const VmaDeviceMemoryCallbacks deviceCallbacks{onDeviceAllocate, onDeviceFree, nullptr};
+}
+
+// the array and nothrow forms forward to these by default
+void* operator new(std::size_t size)
+{ return allocate(size); }
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{ return allocateAligned(size, alignment); }
+
+void operator delete(void* pointer) noexcept
+{
+    release(pointer);
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    release(pointer);
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{ freeAligned(pointer); }
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept
+{ freeAligned(pointer); }
+
+const VmaDeviceMemoryCallbacks* Hellion::HAllocationTracker::deviceMemoryCallbacks()
+{
+    return &deviceCallbacks;
+}
+
+#else
+
+const VmaDeviceMemoryCallbacks* Hellion::HAllocationTracker::deviceMemoryCallbacks()
+{
+    return nullptr;
+}
+
+#endif
+
+Hellion::HAllocationScopeStats::HAllocationScopeStats(const char* name, bool forbidden) : name{name}, forbidden{forbidden}
+{
+    next = scopes.load(std::memory_order_relaxed);
+    while(!scopes.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed))
+    {}
+}
+
+Hellion::HAllocationScope::HAllocationScope(HAllocationScopeStats& stats) : previous{currentScope}
+{
+    currentScope = &stats;
+}
+
+Hellion::HAllocationScope::~HAllocationScope()
+{
+    currentScope = previous;
+}
+
+uint64_t Hellion::HAllocationTracker::allocations()
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+void Hellion::HAllocationTracker::endFrame()
+{
+    if(!enabled())
+        return;
+    auto counts = now();
+    // the first call only marks the start, loading is not a frame
+    if(frameStarted)
+    {
+        lastFrame = HAllocationCounts{counts.allocations - frameStart.allocations, counts.bytes - frameStart.bytes,
+                                      counts.deviceAllocations - frameStart.deviceAllocations, counts.deviceBytes - frameStart.deviceBytes};
+        peakFrame = HAllocationCounts{std::max(peakFrame.allocations, lastFrame.allocations), std::max(peakFrame.bytes, lastFrame.bytes),
+                                      std::max(peakFrame.deviceAllocations, lastFrame.deviceAllocations),
+                                      std::max(peakFrame.deviceBytes, lastFrame.deviceBytes)};
+        frameTotal.allocations += lastFrame.allocations;
+        frameTotal.bytes += lastFrame.bytes;
+        frameTotal.deviceAllocations += lastFrame.deviceAllocations;
+        frameTotal.deviceBytes += lastFrame.deviceBytes;
+        frames++;
+    }
+    frameStart = counts;
+
+#ifdef HELLION_PROFILING
+    TracyPlot("Heap allocations", static_cast<int64_t>(lastFrame.allocations));
+    TracyPlot("Heap bytes", static_cast<int64_t>(lastFrame.bytes));
+    TracyPlot("Device allocations", static_cast<int64_t>(lastFrame.deviceAllocations));
+#endif
+
+    for(auto scope = scopes.load(std::memory_order_acquire); scope; scope = scope->next)
+    {
+        uint64_t scopeAllocations = scope->allocations.load(std::memory_order_relaxed);
+        scope->lastFrameAllocations = frameStarted ? scopeAllocations - scope->frameStartAllocations : 0;
+        scope->frameStartAllocations = scopeAllocations;
+        if(scope->forbidden && scope->lastFrameAllocations > 0 && !scope->warned)
+        {
+            fmt::println("{} allocated {} times in a frame but is held to zero allocations", scope->name, scope->lastFrameAllocations);
+            scope->warned = true;
+        }
+    }
+    frameStarted = true;
+}
+
+const Hellion::HAllocationCounts& Hellion::HAllocationTracker::getLastFrame()
+{
+    return lastFrame;
+}
+
+const Hellion::HAllocationCounts& Hellion::HAllocationTracker::getPeakFrame()
+{
+    return peakFrame;
+}
+
+void Hellion::HAllocationTracker::report()
+{
+    if(!enabled() || frames == 0)
+        return;
+    double count = static_cast<double>(frames);
+    fmt::println("heap allocations over {} frames: {:.1f} per frame ({:.1f} KB), peak {} ({:.1f} KB)", frames, frameTotal.allocations / count,
+                 frameTotal.bytes / count / 1024.0, peakFrame.allocations, peakFrame.bytes / 1024.0);
+    fmt::println("device memory allocations during frames: {} ({:.1f} MB), peak {} in a frame", frameTotal.deviceAllocations,
+                 frameTotal.deviceBytes / (1024.0 * 1024.0), peakFrame.deviceAllocations);
+    for(auto scope = scopes.load(std::memory_order_acquire); scope; scope = scope->next)
+    {
+        uint64_t scopeAllocations = scope->allocations.load(std::memory_order_relaxed);
+        if(scopeAllocations == 0)
+            continue;
+        fmt::println("  {}: {} allocations ({:.1f} KB){}", scope->name, scopeAllocations, scope->bytes.load(std::memory_order_relaxed) / 1024.0,
+                     scope->forbidden ? ", held to zero" : "");
+    }
+}
@@ -0,0 +1,45 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/core/HFrameArena.h"
+#include <algorithm>
+#include <bit>
+
+Hellion::HFrameArena::HFrameArena(size_t capacity) : buffer{std::make_unique<std::byte[]>(capacity)}, capacity{capacity}
+{}
+
+void Hellion::HFrameArena::reset()
+{
+    auto upstream = std::pmr::new_delete_resource();
+    for(const auto& block: overflow)
+        upstream->deallocate(block.pointer, block.bytes, block.alignment);
+    if(!overflow.empty() && std::bit_ceil(peak) > capacity)
+    {
+        capacity = std::bit_ceil(peak);
+        buffer = std::make_unique<std::byte[]>(capacity);
+    }
+    overflow.clear();
+    offset = 0;
+    used = 0;
+}
+
+void* Hellion::HFrameArena::do_allocate(size_t bytes, size_t alignment)
+{
+    // make_unique<std::byte[]> memory is aligned for any fundamental type, only the offset needs aligning
+    size_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+    if(alignment <= alignof(std::max_align_t) && aligned + bytes <= capacity)
+    {
+        used += aligned + bytes - offset;
+        peak = std::max(peak, used);
+        offset = aligned + bytes;
+        return buffer.get() + aligned;
+    }
+
+    used += bytes;
+    peak = std::max(peak, used);
+    overflowCount++;
+    void* pointer = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    overflow.push_back(Overflow{pointer, bytes, alignment});
+    return pointer;
+}
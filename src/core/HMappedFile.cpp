@@ -0,0 +1,158 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/core/HMappedFile.h"
+#include <filesystem>
+#include <fstream>
+#include <fmt/core.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+Hellion::HMappedFile& Hellion::HMappedFile::operator=(Hellion::HMappedFile&& other) noexcept
+{
+    if(this != &other)
+    {
+        close();
+        data = other.data;
+        size = other.size;
+        other.data = nullptr;
+        other.size = 0;
+#ifdef _WIN32
+        fileHandle = other.fileHandle;
+        mappingHandle = other.mappingHandle;
+        other.fileHandle = nullptr;
+        other.mappingHandle = nullptr;
+#endif
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool Hellion::HMappedFile::open(const std::string& path)
+{
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if(file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mapping == nullptr)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if(data == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    size = static_cast<size_t>(fileSize.QuadPart);
+    fileHandle = file;
+    mappingHandle = mapping;
+    return true;
+}
+
+void Hellion::HMappedFile::close()
+{
+    if(data != nullptr)
+        UnmapViewOfFile(data);
+    if(mappingHandle != nullptr)
+        CloseHandle(mappingHandle);
+    if(fileHandle != nullptr)
+        CloseHandle(fileHandle);
+    data = nullptr;
+    size = 0;
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+}
+
+#else
+
+bool Hellion::HMappedFile::open(const std::string& path)
+{
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+
+    struct stat st{};
+    if(fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping keeps its own reference to the file
+    ::close(fd);
+    if(mapped == MAP_FAILED)
+        return false;
+
+    madvise(mapped, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+    data = mapped;
+    size = static_cast<size_t>(st.st_size);
+    return true;
+}
+
+void Hellion::HMappedFile::close()
+{
+    if(data != nullptr)
+        munmap(const_cast<void*>(data), size);
+    data = nullptr;
+    size = 0;
+}
+
+#endif
+
+bool Hellion::writeFileAtomically(const std::string& path, std::span<const std::byte> bytes)
+{
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if(!out.is_open())
+        {
+            fmt::println("failed to write {}", path);
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if(!out)
+        {
+            fmt::println("failed to write {}", path);
+            out.close();
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    if(ec)
+    {
+        fmt::println("failed to write {}: {}", path, ec.message());
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,136 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/core/HProfiler.h"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <fmt/core.h>
+#include <nlohmann/json.hpp>
+
+namespace
+{
+    constexpr double NS_PER_MS = 1000000.0;
+}
+
+Hellion::HProfiler& Hellion::HProfiler::global()
+{
+    static HProfiler profiler;
+    return profiler;
+}
+
+Hellion::HProfiler::HProfiler() : ring{std::make_unique<Slot[]>(RING_SIZE)}, frameStartNs{now()}
+{}
+
+void Hellion::HProfiler::record(const char* name, uint64_t startNs, uint64_t endNs)
+{
+    uint64_t index = writeIndex.load(std::memory_order_relaxed);
+    do
+    {
+        // the slot still holds a sample endFrame has not copied
+        if(index - readIndex.load(std::memory_order_acquire) >= RING_SIZE)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    } while(!writeIndex.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+    auto& slot = ring[index & (RING_SIZE - 1)];
+    slot.sample = Sample{name, startNs, endNs};
+    slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+void Hellion::HProfiler::endFrame()
+{
+    uint64_t end = writeIndex.load(std::memory_order_acquire);
+    uint64_t read = readIndex.load(std::memory_order_relaxed);
+    // a slot that is claimed but not written yet stops the drain, it is picked up next frame
+    for(; read < end; read++)
+    {
+        auto& slot = ring[read & (RING_SIZE - 1)];
+        if(slot.sequence.load(std::memory_order_acquire) != read + 1)
+            break;
+        Sample sample = slot.sample;
+
+        auto [it, inserted] = scopeIndices.try_emplace(sample.name, scopes.size());
+        if(inserted)
+        {
+            scopes.push_back(HScopeStats{sample.name});
+            frameNs.push_back(0);
+            frameCalls.push_back(0);
+        }
+        frameNs[it->second] += sample.endNs - sample.startNs;
+        frameCalls[it->second]++;
+    }
+    // the copied slots can be claimed again
+    readIndex.store(read, std::memory_order_release);
+
+    for(size_t i = 0; i < scopes.size(); i++)
+    {
+        auto& scope = scopes[i];
+        scope.lastMs = static_cast<double>(frameNs[i]) / NS_PER_MS;
+        if(frameCalls[i] > 0)
+        {
+            scope.totalMs += scope.lastMs;
+            scope.maxMs = std::max(scope.maxMs, scope.lastMs);
+            scope.calls += frameCalls[i];
+            scope.frames++;
+        }
+        frameNs[i] = 0;
+        frameCalls[i] = 0;
+    }
+
+    uint64_t time = now();
+    auto& timing = history[frame % HISTORY_SIZE];
+    timing = HFrameTiming{frame, static_cast<double>(time - frameStartNs) / NS_PER_MS, -1.0};
+    frameStartNs = time;
+    frame++;
+}
+
+void Hellion::HProfiler::recordGpuFrame(uint64_t gpuFrame, double milliseconds)
+{
+    auto& timing = history[gpuFrame % HISTORY_SIZE];
+    if(timing.frame == gpuFrame)
+        timing.gpuMs = milliseconds;
+}
+
+void Hellion::HProfiler::dumpCsv(const std::string& path) const
+{
+    std::ofstream out(path);
+    if(!out)
+        throw std::runtime_error("failed to write profile csv!");
+    out << "frame,cpu_ms,gpu_ms\n";
+    uint64_t first = frame > HISTORY_SIZE ? frame - HISTORY_SIZE : 0;
+    for(uint64_t i = first; i < frame; i++)
+    {
+        const auto& timing = history[i % HISTORY_SIZE];
+        out << timing.frame << ',' << timing.cpuMs << ',';
+        if(timing.gpuMs >= 0.0)
+            out << timing.gpuMs;
+        out << '\n';
+    }
+    fmt::println("frame times written to {}", path);
+}
+
+void Hellion::HProfiler::dumpJson(const std::string& path) const
+{
+    nlohmann::json json;
+    json["Frames"] = nlohmann::json::array();
+    uint64_t first = frame > HISTORY_SIZE ? frame - HISTORY_SIZE : 0;
+    for(uint64_t i = first; i < frame; i++)
+    {
+        const auto& timing = history[i % HISTORY_SIZE];
+        json["Frames"].push_back({{"Frame", timing.frame}, {"CpuMs", timing.cpuMs}, {"GpuMs", timing.gpuMs >= 0.0 ? nlohmann::json(timing.gpuMs) : nullptr}});
+    }
+    json["Scopes"] = nlohmann::json::array();
+    for(const auto& scope: scopes)
+        json["Scopes"].push_back({{"Name", scope.name}, {"Calls", scope.calls}, {"Frames", scope.frames}, {"AverageMs", scope.averageMs()},
+                                  {"MaxMs", scope.maxMs}, {"TotalMs", scope.totalMs}});
+    json["DroppedSamples"] = getDropped();
+
+    std::ofstream out(path);
+    if(!out)
+        throw std::runtime_error("failed to write profile json!");
+    out << json.dump(2);
+    fmt::println("profile written to {}", path);
+}
@@ -0,0 +1,91 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/core/HRangeAllocator.h"
+#include <cassert>
+#include <iterator>
+
+std::optional<uint64_t> Hellion::HRangeAllocator::allocate(uint64_t size, uint64_t alignment)
+{
+    if(size == 0)
+        return std::nullopt;
+
+    // the smallest block that still fits once its start is aligned
+    for(auto it = bySize.lower_bound(size); it != bySize.end(); ++it)
+    {
+        uint64_t blockOffset = it->second;
+        uint64_t blockSize = it->first;
+        uint64_t aligned = (blockOffset + alignment - 1) / alignment * alignment;
+        uint64_t padding = aligned - blockOffset;
+        if(padding + size > blockSize)
+            continue;
+
+        eraseFree(byOffset.find(blockOffset));
+        if(padding > 0)
+            insertFree(blockOffset, padding);
+        if(padding + size < blockSize)
+            insertFree(aligned + size, blockSize - padding - size);
+        freeSpace -= size;
+        return aligned;
+    }
+    return std::nullopt;
+}
+
+void Hellion::HRangeAllocator::free(uint64_t offset, uint64_t size)
+{
+    assert(offset + size <= capacity && "range is outside of the allocator");
+    freeSpace += size;
+
+    auto next = byOffset.lower_bound(offset);
+    if(next != byOffset.begin())
+    {
+        auto previous = std::prev(next);
+        assert(previous->first + previous->second <= offset && "range is already free");
+        if(previous->first + previous->second == offset)
+        {
+            offset = previous->first;
+            size += previous->second;
+            eraseFree(previous);
+        }
+    }
+    if(next != byOffset.end() && offset + size == next->first)
+    {
+        size += next->second;
+        eraseFree(next);
+    }
+    insertFree(offset, size);
+}
+
+void Hellion::HRangeAllocator::reset(uint64_t newCapacity)
+{
+    capacity = newCapacity;
+    freeSpace = 0;
+    byOffset.clear();
+    bySize.clear();
+    if(capacity > 0)
+    {
+        insertFree(0, capacity);
+        freeSpace = capacity;
+    }
+}
+
+void Hellion::HRangeAllocator::insertFree(uint64_t offset, uint64_t size)
+{
+    byOffset.emplace(offset, size);
+    bySize.emplace(size, offset);
+}
+
+void Hellion::HRangeAllocator::eraseFree(std::map<uint64_t, uint64_t>::iterator block)
+{
+    auto [first, last] = bySize.equal_range(block->second);
+    for(auto it = first; it != last; ++it)
+    {
+        if(it->second == block->first)
+        {
+            bySize.erase(it);
+            break;
+        }
+    }
+    byOffset.erase(block);
+}
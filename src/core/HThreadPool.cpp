@@ -0,0 +1,125 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/core/HThreadPool.h"
+#include <atomic>
+#include <exception>
+
+Hellion::HThreadPool::HThreadPool(size_t threadCount)
+{
+    workers.reserve(threadCount);
+    for(size_t i = 0; i < threadCount; i++)
+        workers.emplace_back([this]()
+                             { workerLoop(); });
+}
+
+Hellion::HThreadPool::~HThreadPool()
+{
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    for(auto& worker: workers)
+        worker.join();
+}
+
+void Hellion::HThreadPool::workerLoop()
+{
+    while(true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(mutex);
+            condition.wait(lock, [this]()
+            { return stopping || !tasks.empty(); });
+            if(stopping && tasks.empty())
+                return;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+bool Hellion::HThreadPool::runPendingTask()
+{
+    std::function<void()> task;
+    {
+        std::lock_guard lock(mutex);
+        if(tasks.empty())
+            return false;
+        task = std::move(tasks.front());
+        tasks.pop_front();
+    }
+    task();
+    return true;
+}
+
+void Hellion::HThreadPool::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body)
+{
+    if(count == 0)
+        return;
+    grain = std::max<size_t>(grain, 1);
+    size_t rangeCount = (count + grain - 1) / grain;
+    if(rangeCount == 1)
+    {
+        body(0, count);
+        return;
+    }
+
+    std::atomic<size_t> nextRange{0};
+    auto runRanges = [&]()
+    {
+        try
+        {
+            for(size_t range = nextRange++; range < rangeCount; range = nextRange++)
+                body(range * grain, std::min(count, (range + 1) * grain));
+        } catch(...)
+        {
+            // the other threads stop taking ranges
+            nextRange = rangeCount;
+            throw;
+        }
+    };
+
+    std::vector<std::future<void>> helpers;
+    std::exception_ptr error;
+    try
+    {
+        size_t helperCount = std::min(rangeCount - 1, workers.size());
+        helpers.reserve(helperCount);
+        for(size_t i = 0; i < helperCount; i++)
+            helpers.push_back(submit(runRanges));
+        runRanges();
+    } catch(...)
+    {
+        error = std::current_exception();
+    }
+
+    // the helpers reference this frame, all of them have to finish before it unwinds
+    // help with other queued work instead of blocking while helpers finish
+    for(auto& helper: helpers)
+    {
+        while(helper.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            if(!runPendingTask())
+                helper.wait();
+        try
+        {
+            helper.get();
+        } catch(...)
+        {
+            if(!error)
+                error = std::current_exception();
+        }
+    }
+    if(error)
+        std::rethrow_exception(error);
+}
+
+Hellion::HThreadPool& Hellion::HThreadPool::global()
+{
+    static HThreadPool pool;
+    return pool;
+}
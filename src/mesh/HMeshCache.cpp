@@ -0,0 +1,126 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/mesh/HMeshCache.h"
+#include "../../include/core/HHash.h"
+#include "../../include/core/Profiling.h"
+#include <chrono>
+#include <cstring>
+#include <fmt/core.h>
+
+namespace
+{
+    uint64_t alignUp(uint64_t value, uint64_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+uint64_t Hellion::HMeshCache::hashSource(const std::string& sourcePath)
+{
+    // the import layout is part of the identity, changing HVertex invalidates every cache
+    uint32_t stride = sizeof(HVertex);
+    return fnv1a(&stride, sizeof(stride), hashFileIdentity(sourcePath));
+}
+
+std::optional<Hellion::HMappedMesh> Hellion::HMeshCache::load(const std::string& cachePath, uint64_t sourceHash, HVertexFormat format)
+{
+    HELLION_ZONE_PROFILING()
+    HMappedFile file;
+    if(!file.open(cachePath) || file.getSize() < sizeof(HMeshHeader))
+        return std::nullopt;
+
+    auto& header = *reinterpret_cast<const HMeshHeader*>(file.bytes().data());
+    // serialize may have fallen back to half uvs, the header holds the format that was written
+    bool formatMatches = header.vertexFormat == format || header.vertexFormat == HVertexEncoding::halfUvFormat(format);
+    if(header.magic != HMeshHeader::MAGIC || header.version != HMeshHeader::VERSION || header.sourceHash != sourceHash || !formatMatches ||
+       header.vertexStride != HVertexEncoding::stride(header.vertexFormat))
+        return std::nullopt;
+
+    uint64_t vertexEnd = header.vertexOffset + static_cast<uint64_t>(header.vertexCount) * header.vertexStride;
+    uint64_t indexEnd = header.indexOffset + static_cast<uint64_t>(header.indexCount) * sizeof(uint32_t);
+    uint64_t lodEnd = header.lodOffset + static_cast<uint64_t>(header.lodCount) * sizeof(HMeshLod);
+    uint64_t meshletEnd = header.meshletOffset + static_cast<uint64_t>(header.meshletCount) * sizeof(HMeshlet);
+    if(vertexEnd > file.getSize() || indexEnd > file.getSize() || lodEnd > file.getSize() || meshletEnd > file.getSize() || header.lodCount == 0)
+        return std::nullopt;
+
+    return HMappedMesh{std::move(file)};
+}
+
+std::vector<std::byte> Hellion::HMeshCache::serialize(const HMeshData& mesh, uint64_t sourceHash, HVertexFormat format)
+{
+    HELLION_ZONE_PROFILING()
+    format = HVertexEncoding::resolve(mesh, format);
+    auto quantization = HQuantization::fromBounds(mesh.bounds);
+    auto vertexBytes = HVertexEncoding::encode(mesh, format, quantization);
+    // meshes imported without a LOD chain are stored as a single full detail LOD
+    std::vector<HMeshLod> lods = mesh.lods;
+    if(lods.empty())
+        lods.push_back({0, static_cast<uint32_t>(mesh.indices.size()), 0.0f});
+
+    HMeshHeader header{};
+    header.magic = HMeshHeader::MAGIC;
+    header.version = HMeshHeader::VERSION;
+    header.sourceHash = sourceHash;
+    header.vertexStride = HVertexEncoding::stride(format);
+    header.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    header.indexCount = static_cast<uint32_t>(mesh.indices.size());
+    header.vertexFormat = format;
+    header.lodCount = static_cast<uint32_t>(lods.size());
+    header.meshletCount = static_cast<uint32_t>(mesh.meshlets.size());
+    for(int i = 0; i < 3; i++)
+    {
+        header.boundsMin[i] = mesh.bounds.min[i];
+        header.boundsMax[i] = mesh.bounds.max[i];
+        header.quantizationOffset[i] = format == HVertexFormat::Full ? 0.0f : quantization.offset[i];
+        header.quantizationScale[i] = format == HVertexFormat::Full ? 1.0f : quantization.scale[i];
+    }
+    header.vertexOffset = alignUp(sizeof(HMeshHeader), 16);
+    header.indexOffset = alignUp(header.vertexOffset + vertexBytes.size(), 16);
+    header.lodOffset = alignUp(header.indexOffset + mesh.indices.size() * sizeof(uint32_t), 16);
+    header.meshletOffset = alignUp(header.lodOffset + lods.size() * sizeof(HMeshLod), 16);
+
+    // zero filled, so the alignment padding is deterministic
+    std::vector<std::byte> bytes(header.meshletOffset + mesh.meshlets.size() * sizeof(HMeshlet));
+    auto writeAt = [&bytes](uint64_t offset, const void* data, size_t size)
+    {
+        if(size > 0)
+            std::memcpy(bytes.data() + offset, data, size);
+    };
+    writeAt(0, &header, sizeof(header));
+    writeAt(header.vertexOffset, vertexBytes.data(), vertexBytes.size());
+    writeAt(header.indexOffset, mesh.indices.data(), mesh.indices.size() * sizeof(uint32_t));
+    writeAt(header.lodOffset, lods.data(), lods.size() * sizeof(HMeshLod));
+    writeAt(header.meshletOffset, mesh.meshlets.data(), mesh.meshlets.size() * sizeof(HMeshlet));
+    return bytes;
+}
+
+Hellion::HMappedMesh Hellion::HMeshCache::loadOrImport(const std::string& sourcePath, const std::function<HMeshData(const std::string&)>& importer,
+                                                       HVertexFormat format)
+{
+    HELLION_ZONE_PROFILING()
+    auto start = std::chrono::steady_clock::now();
+    auto cachePath = cachePathFor(sourcePath, format);
+    auto hash = hashSource(sourcePath);
+
+    if(auto cached = load(cachePath, hash, format))
+    {
+        fmt::println("mesh {} loaded from cache in {:.2f} ms", sourcePath,
+                     std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        return std::move(*cached);
+    }
+
+    HMeshData mesh = importer(sourcePath);
+    mesh.computeBounds();
+    auto bytes = serialize(mesh, hash, format);
+    bool written = writeFileAtomically(cachePath, bytes);
+    fmt::println("mesh {} imported in {:.2f} ms", sourcePath,
+                 std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+    // the mapping lets the OS page the mesh out, the heap copy is only kept when the cache is unavailable
+    if(written)
+        if(auto cached = load(cachePath, hash, format))
+            return std::move(*cached);
+    return HMappedMesh{std::move(bytes)};
+}
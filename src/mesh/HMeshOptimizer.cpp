@@ -0,0 +1,314 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/mesh/HMeshOptimizer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+    constexpr int SCORING_CACHE_SIZE = 32;
+
+    float vertexScore(int cachePosition, uint32_t liveTriangles)
+    {
+        if(liveTriangles == 0)
+            return -1.0f;
+
+        float score = 0.0f;
+        if(cachePosition >= 0)
+        {
+            // the last triangle's vertices get a fixed score so the next triangle does not just reuse the same edge
+            if(cachePosition < 3)
+                score = 0.75f;
+            else
+                score = std::pow(1.0f - static_cast<float>(cachePosition - 3) / (SCORING_CACHE_SIZE - 3), 1.5f);
+        }
+        // favour vertices with few remaining triangles to finish them off
+        score += 2.0f / std::sqrt(static_cast<float>(liveTriangles));
+        return score;
+    }
+
+    struct Vec3
+    {
+        float x, y, z;
+
+        Vec3 operator+(const Vec3& o) const
+        { return {x + o.x, y + o.y, z + o.z}; }
+
+        Vec3 operator-(const Vec3& o) const
+        { return {x - o.x, y - o.y, z - o.z}; }
+
+        Vec3 operator*(float s) const
+        { return {x * s, y * s, z * s}; }
+
+        float dot(const Vec3& o) const
+        { return x * o.x + y * o.y + z * o.z; }
+
+        Vec3 cross(const Vec3& o) const
+        { return {y * o.z - z * o.y, z * o.x - x * o.z, x * o.y - y * o.x}; }
+
+        float length() const
+        { return std::sqrt(dot(*this)); }
+    };
+
+    Vec3 position(const float* positions, size_t stride, uint32_t index)
+    {
+        auto p = reinterpret_cast<const float*>(reinterpret_cast<const char*>(positions) + stride * index);
+        return {p[0], p[1], p[2]};
+    }
+}
+
+void Hellion::HMeshOptimizer::optimizeVertexCache(std::span<uint32_t> indices, size_t vertexCount)
+{
+    size_t triangleCount = indices.size() / 3;
+    if(triangleCount == 0)
+        return;
+
+    // vertex -> triangle adjacency, the live part of each list shrinks as triangles are emitted
+    std::vector<uint32_t> liveTriangles(vertexCount, 0);
+    for(uint32_t index: indices)
+        liveTriangles[index]++;
+
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for(size_t v = 0; v < vertexCount; v++)
+        offsets[v + 1] = offsets[v] + liveTriangles[v];
+
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for(size_t t = 0; t < triangleCount; t++)
+        for(size_t k = 0; k < 3; k++)
+            adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for(size_t v = 0; v < vertexCount; v++)
+        vertexScores[v] = vertexScore(-1, liveTriangles[v]);
+
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    int64_t best = 0;
+    for(size_t t = 0; t < triangleCount; t++)
+    {
+        triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+        if(triangleScores[t] > triangleScores[best])
+            best = static_cast<int64_t>(t);
+    }
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+
+    std::array<uint32_t, SCORING_CACHE_SIZE + 3> cache{};
+    std::array<uint32_t, SCORING_CACHE_SIZE + 3> newCache{};
+    size_t cacheCount = 0;
+    size_t cursor = 0;
+
+    while(result.size() < indices.size())
+    {
+        if(best < 0)
+        {
+            // nothing in the cache has live triangles, continue with the next unemitted triangle in input order
+            while(emitted[cursor])
+                cursor++;
+            best = static_cast<int64_t>(cursor);
+        }
+
+        auto triangle = static_cast<size_t>(best);
+        uint32_t triangleVertices[3] = {indices[triangle * 3], indices[triangle * 3 + 1], indices[triangle * 3 + 2]};
+        result.insert(result.end(), triangleVertices, triangleVertices + 3);
+        emitted[triangle] = true;
+
+        for(uint32_t v: triangleVertices)
+        {
+            auto begin = adjacency.begin() + offsets[v];
+            auto end = begin + liveTriangles[v];
+            std::iter_swap(std::find(begin, end, static_cast<uint32_t>(triangle)), end - 1);
+            liveTriangles[v]--;
+        }
+
+        size_t newCacheCount = 0;
+        for(uint32_t v: triangleVertices)
+            newCache[newCacheCount++] = v;
+        for(size_t i = 0; i < cacheCount; i++)
+        {
+            uint32_t v = cache[i];
+            if(v != triangleVertices[0] && v != triangleVertices[1] && v != triangleVertices[2])
+                newCache[newCacheCount++] = v;
+        }
+
+        for(size_t i = 0; i < newCacheCount; i++)
+            cachePosition[newCache[i]] = i < SCORING_CACHE_SIZE ? static_cast<int>(i) : -1;
+
+        for(size_t i = 0; i < newCacheCount; i++)
+        {
+            uint32_t v = newCache[i];
+            float score = vertexScore(cachePosition[v], liveTriangles[v]);
+            float diff = score - vertexScores[v];
+            vertexScores[v] = score;
+            for(uint32_t a = offsets[v]; a < offsets[v] + liveTriangles[v]; a++)
+                triangleScores[adjacency[a]] += diff;
+        }
+
+        best = -1;
+        float bestScore = -1.0f;
+        cacheCount = std::min<size_t>(newCacheCount, SCORING_CACHE_SIZE);
+        for(size_t i = 0; i < cacheCount; i++)
+        {
+            uint32_t v = newCache[i];
+            cache[i] = v;
+            for(uint32_t a = offsets[v]; a < offsets[v] + liveTriangles[v]; a++)
+            {
+                uint32_t t = adjacency[a];
+                if(triangleScores[t] > bestScore)
+                {
+                    bestScore = triangleScores[t];
+                    best = t;
+                }
+            }
+        }
+    }
+
+    std::copy(result.begin(), result.end(), indices.begin());
+}
+
+void Hellion::HMeshOptimizer::optimizeOverdraw(std::span<uint32_t> indices, const float* positions, size_t vertexCount, size_t positionStride,
+                                               float threshold)
+{
+    size_t triangleCount = indices.size() / 3;
+    if(triangleCount == 0)
+        return;
+
+    auto before = analyzeVertexCache(indices, vertexCount);
+
+    // a cluster ends where the cache simulation misses all three vertices, reordering clusters there costs almost no cache efficiency
+    std::vector<size_t> clusterStarts;
+    std::vector<uint32_t> fifoTime(vertexCount, 0);
+    uint32_t time = SIMULATED_CACHE_SIZE + 1;
+    for(size_t t = 0; t < triangleCount; t++)
+    {
+        int misses = 0;
+        for(size_t k = 0; k < 3; k++)
+        {
+            uint32_t v = indices[t * 3 + k];
+            if(time - fifoTime[v] > SIMULATED_CACHE_SIZE)
+            {
+                fifoTime[v] = time++;
+                misses++;
+            }
+        }
+        if(misses == 3 || t == 0)
+            clusterStarts.push_back(t);
+    }
+    clusterStarts.push_back(triangleCount);
+
+    Vec3 meshCentroid{0.0f, 0.0f, 0.0f};
+    float meshArea = 0.0f;
+
+    struct Cluster
+    {
+        size_t begin;
+        size_t end;
+        Vec3 centroid;
+        Vec3 normal;
+        float sortKey;
+    };
+    std::vector<Cluster> clusters(clusterStarts.size() - 1);
+
+    for(size_t c = 0; c < clusters.size(); c++)
+    {
+        auto& cluster = clusters[c];
+        cluster.begin = clusterStarts[c];
+        cluster.end = clusterStarts[c + 1];
+        cluster.centroid = {0.0f, 0.0f, 0.0f};
+        cluster.normal = {0.0f, 0.0f, 0.0f};
+
+        float clusterArea = 0.0f;
+        for(size_t t = cluster.begin; t < cluster.end; t++)
+        {
+            Vec3 a = position(positions, positionStride, indices[t * 3]);
+            Vec3 b = position(positions, positionStride, indices[t * 3 + 1]);
+            Vec3 c3 = position(positions, positionStride, indices[t * 3 + 2]);
+            Vec3 n = (b - a).cross(c3 - a);
+            float area = n.length();
+            cluster.centroid = cluster.centroid + (a + b + c3) * (area / 3.0f);
+            cluster.normal = cluster.normal + n;
+            clusterArea += area;
+        }
+        meshCentroid = meshCentroid + cluster.centroid;
+        meshArea += clusterArea;
+        if(clusterArea > 0.0f)
+            cluster.centroid = cluster.centroid * (1.0f / clusterArea);
+    }
+    if(meshArea > 0.0f)
+        meshCentroid = meshCentroid * (1.0f / meshArea);
+
+    for(auto& cluster: clusters)
+    {
+        float length = cluster.normal.length();
+        Vec3 normal = length > 0.0f ? cluster.normal * (1.0f / length) : Vec3{0.0f, 0.0f, 0.0f};
+        cluster.sortKey = (cluster.centroid - meshCentroid).dot(normal);
+    }
+
+    // clusters that face away from the center are likely to occlude the rest, draw them first
+    std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b)
+    { return a.sortKey > b.sortKey; });
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    for(const auto& cluster: clusters)
+        result.insert(result.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+
+    auto after = analyzeVertexCache(result, vertexCount);
+    if(after.acmr <= before.acmr * threshold)
+        std::copy(result.begin(), result.end(), indices.begin());
+}
+
+std::vector<uint32_t> Hellion::HMeshOptimizer::optimizeVertexFetch(std::span<uint32_t> indices, size_t vertexCount)
+{
+    constexpr uint32_t UNUSED = ~0u;
+    std::vector<uint32_t> remap(vertexCount, UNUSED);
+    uint32_t next = 0;
+    for(uint32_t& index: indices)
+    {
+        if(remap[index] == UNUSED)
+            remap[index] = next++;
+        index = remap[index];
+    }
+    for(uint32_t& entry: remap)
+        if(entry == UNUSED)
+            entry = next++;
+    return remap;
+}
+
+Hellion::HVertexCacheStats Hellion::HMeshOptimizer::analyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount, uint32_t cacheSize)
+{
+    HVertexCacheStats stats{};
+    if(indices.empty())
+        return stats;
+
+    // FIFO cache, a vertex is still cached while less than cacheSize misses happened after it was loaded
+    std::vector<uint32_t> fifoTime(vertexCount, 0);
+    std::vector<bool> referenced(vertexCount, false);
+    uint32_t time = cacheSize + 1;
+    size_t misses = 0;
+    size_t uniqueVertices = 0;
+    for(uint32_t index: indices)
+    {
+        if(time - fifoTime[index] > cacheSize)
+        {
+            fifoTime[index] = time++;
+            misses++;
+        }
+        if(!referenced[index])
+        {
+            referenced[index] = true;
+            uniqueVertices++;
+        }
+    }
+
+    stats.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+    stats.atvr = static_cast<float>(misses) / static_cast<float>(uniqueVertices);
+    return stats;
+}
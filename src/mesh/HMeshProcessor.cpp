@@ -0,0 +1,105 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/mesh/HMeshProcessor.h"
+#include "../../include/mesh/HMeshOptimizer.h"
+#include "../../include/mesh/HMeshSimplifier.h"
+#include "../../include/core/Profiling.h"
+#include <algorithm>
+#include <cstddef>
+#include <fmt/core.h>
+
+namespace
+{
+    void report(const char* pass, const Hellion::HVertexCacheStats& before, const Hellion::HVertexCacheStats& after)
+    {
+        fmt::println("  {:<14} ACMR {:.3f} -> {:.3f}  ATVR {:.3f} -> {:.3f}", pass, before.acmr, after.acmr, before.atvr, after.atvr);
+    }
+
+    /// pos is the first member, so the vertex array is the position stream with a stride of sizeof(HVertex)
+    const float* positions(const std::vector<Hellion::HVertex>& vertices)
+    {
+        static_assert(offsetof(Hellion::HVertex, pos) == 0);
+        return reinterpret_cast<const float*>(vertices.data());
+    }
+}
+
+void Hellion::HMeshProcessor::process(HMeshData& mesh)
+{
+    HELLION_ZONE_PROFILING()
+    // an OBJ without faces has nothing to optimize, split or simplify
+    if(mesh.indices.empty())
+        return;
+    optimize(mesh);
+    mesh.computeNormals();
+    mesh.computeBounds();
+    buildMeshlets(mesh);
+    generateLods(mesh);
+}
+
+void Hellion::HMeshProcessor::buildMeshlets(HMeshData& mesh)
+{
+    HELLION_ZONE_PROFILING()
+    size_t indexCount = mesh.lods.empty() ? mesh.indices.size() : mesh.lods[0].indexCount;
+    mesh.meshlets = HMeshletBuilder::build(std::span(mesh.indices).first(indexCount), positions(mesh.vertices), mesh.vertices.size(), sizeof(HVertex));
+
+    size_t coneCullable = std::count_if(mesh.meshlets.begin(), mesh.meshlets.end(), [](const HMeshlet& meshlet)
+    { return meshlet.coneCutoff < 1.0f; });
+    fmt::println("  meshlets {}, {:.1f} triangles each, {} with a usable normal cone", mesh.meshlets.size(),
+                 mesh.meshlets.empty() ? 0.0f : static_cast<float>(indexCount / 3) / static_cast<float>(mesh.meshlets.size()), coneCullable);
+}
+
+void Hellion::HMeshProcessor::optimize(HMeshData& mesh)
+{
+    HELLION_ZONE_PROFILING()
+    size_t vertexCount = mesh.vertices.size();
+    fmt::println("optimizing mesh, {} triangles", mesh.indices.size() / 3);
+
+    auto stats = HMeshOptimizer::analyzeVertexCache(mesh.indices, vertexCount);
+    HMeshOptimizer::optimizeVertexCache(mesh.indices, vertexCount);
+    auto cacheStats = HMeshOptimizer::analyzeVertexCache(mesh.indices, vertexCount);
+    report("vertex cache", stats, cacheStats);
+
+    HMeshOptimizer::optimizeOverdraw(mesh.indices, positions(mesh.vertices), vertexCount, sizeof(HVertex));
+    auto overdrawStats = HMeshOptimizer::analyzeVertexCache(mesh.indices, vertexCount);
+    report("overdraw", cacheStats, overdrawStats);
+
+    auto remap = HMeshOptimizer::optimizeVertexFetch(mesh.indices, vertexCount);
+    HMeshOptimizer::remapVertices(mesh.vertices, remap);
+    auto fetchStats = HMeshOptimizer::analyzeVertexCache(mesh.indices, vertexCount);
+    report("vertex fetch", overdrawStats, fetchStats);
+}
+
+void Hellion::HMeshProcessor::generateLods(HMeshData& mesh)
+{
+    HELLION_ZONE_PROFILING()
+    size_t vertexCount = mesh.vertices.size();
+    std::vector<uint32_t> source = mesh.indices;
+    mesh.lods = {HMeshLod{0, static_cast<uint32_t>(source.size()), 0.0f}};
+    // a LOD that moves the surface by more than the mesh size is never selected
+    float maxError = mesh.bounds.radius() * 2.0f;
+
+    size_t targetIndexCount = source.size();
+    for(uint32_t level = 1; level < MAX_LODS; level++)
+    {
+        targetIndexCount = static_cast<size_t>(static_cast<float>(targetIndexCount / 3) * LOD_REDUCTION) * 3;
+        if(targetIndexCount < MIN_LOD_TRIANGLES * 3)
+            break;
+
+        // every level is simplified from the full mesh so its error is measured against the source surface
+        auto simplified = HMeshSimplifier::simplify(source, positions(mesh.vertices), vertexCount, sizeof(HVertex), targetIndexCount, maxError);
+        const auto& previous = mesh.lods.back();
+        if(simplified.indices.size() > previous.indexCount * 9 / 10)
+            break;
+
+        HMeshOptimizer::optimizeVertexCache(simplified.indices, vertexCount);
+        mesh.lods.push_back({static_cast<uint32_t>(mesh.indices.size()), static_cast<uint32_t>(simplified.indices.size()),
+                             std::max(simplified.error, previous.error)});
+        mesh.indices.insert(mesh.indices.end(), simplified.indices.begin(), simplified.indices.end());
+        targetIndexCount = simplified.indices.size();
+    }
+
+    for(size_t i = 0; i < mesh.lods.size(); i++)
+        fmt::println("  lod {}  {:>8} triangles  error {:.5f}", i, mesh.lods[i].indexCount / 3, mesh.lods[i].error);
+}
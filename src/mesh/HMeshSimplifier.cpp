@@ -0,0 +1,344 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/mesh/HMeshSimplifier.h"
+#include "../../include/mesh/HVertexWelder.h"
+#include "../../include/core/Profiling.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <glm/glm.hpp>
+
+namespace
+{
+    struct Quadric
+    {
+        double a00 = 0, a11 = 0, a22 = 0, a01 = 0, a02 = 0, a12 = 0;
+        double b0 = 0, b1 = 0, b2 = 0;
+        double c = 0;
+        double weight = 0;
+
+        /// plane n.p + d = 0 with a unit normal
+        void addPlane(glm::dvec3 n, double d, double weight)
+        {
+            a00 += weight * n.x * n.x;
+            a11 += weight * n.y * n.y;
+            a22 += weight * n.z * n.z;
+            a01 += weight * n.x * n.y;
+            a02 += weight * n.x * n.z;
+            a12 += weight * n.y * n.z;
+            b0 += weight * n.x * d;
+            b1 += weight * n.y * d;
+            b2 += weight * n.z * d;
+            c += weight * d * d;
+            this->weight += weight;
+        }
+
+        /// weighted mean of the squared distances from p to the accumulated planes
+        double evaluate(glm::dvec3 p) const
+        {
+            if(weight <= 0.0)
+                return 0.0;
+            double rx = a00 * p.x + a01 * p.y + a02 * p.z;
+            double ry = a01 * p.x + a11 * p.y + a12 * p.z;
+            double rz = a02 * p.x + a12 * p.y + a22 * p.z;
+            double result = p.x * rx + p.y * ry + p.z * rz + 2.0 * (b0 * p.x + b1 * p.y + b2 * p.z) + c;
+            return std::max(result, 0.0) / weight;
+        }
+
+        Quadric& operator+=(const Quadric& other)
+        {
+            a00 += other.a00;
+            a11 += other.a11;
+            a22 += other.a22;
+            a01 += other.a01;
+            a02 += other.a02;
+            a12 += other.a12;
+            b0 += other.b0;
+            b1 += other.b1;
+            b2 += other.b2;
+            c += other.c;
+            weight += other.weight;
+            return *this;
+        }
+    };
+
+    struct Collapse
+    {
+        uint32_t from;
+        uint32_t to;
+        double cost;
+    };
+
+    uint64_t edgeKey(uint32_t a, uint32_t b)
+    {
+        return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+    }
+
+    /// Undirected edges of the position-welded triangles, sorted so the number of faces per edge can be looked up.
+    class EdgeSet
+    {
+    public:
+        void build(const std::vector<uint32_t>& indices, const std::vector<uint32_t>& positionOf)
+        {
+            edges.clear();
+            edges.reserve(indices.size());
+            for(size_t i = 0; i < indices.size(); i += 3)
+                for(int k = 0; k < 3; k++)
+                    edges.push_back(edgeKey(positionOf[indices[i + k]], positionOf[indices[i + (k + 1) % 3]]));
+            std::sort(edges.begin(), edges.end());
+        }
+
+        size_t faceCount(uint32_t a, uint32_t b) const
+        {
+            auto range = std::equal_range(edges.begin(), edges.end(), edgeKey(a, b));
+            return static_cast<size_t>(range.second - range.first);
+        }
+
+        template<class F>
+        void forEach(F&& f) const
+        {
+            for(size_t i = 0; i < edges.size();)
+            {
+                size_t j = i;
+                while(j < edges.size() && edges[j] == edges[i])
+                    j++;
+                f(static_cast<uint32_t>(edges[i] >> 32), static_cast<uint32_t>(edges[i] & 0xffffffffu), j - i);
+                i = j;
+            }
+        }
+
+    private:
+        std::vector<uint64_t> edges;
+    };
+}
+
+Hellion::HSimplifiedMesh Hellion::HMeshSimplifier::simplify(std::span<const uint32_t> indices, const float* positions, size_t vertexCount,
+                                                            size_t positionStride, size_t targetIndexCount, float targetError)
+{
+    HELLION_ZONE_PROFILING()
+    HSimplifiedMesh result;
+    result.indices.assign(indices.begin(), indices.end());
+    if(indices.size() <= targetIndexCount)
+        return result;
+
+    // vertices split by UV seams share a position, the topology is built on welded positions
+    std::vector<glm::vec3> welded;
+    std::vector<uint32_t> positionOf(vertexCount);
+    {
+        HVertexWelder<glm::vec3> welder(welded, vertexCount);
+        auto bytes = reinterpret_cast<const std::byte*>(positions);
+        for(size_t i = 0; i < vertexCount; i++)
+        {
+            glm::vec3 p;
+            std::memcpy(&p, bytes + i * positionStride, sizeof(p));
+            positionOf[i] = welder.insert(p);
+        }
+    }
+    size_t positionCount = welded.size();
+
+    std::vector<Quadric> quadrics(positionCount);
+    std::vector<uint8_t> border(positionCount, 0);
+    std::vector<uint8_t> locked(positionCount, 0);
+
+    auto& triangles = result.indices;
+    for(size_t i = 0; i < triangles.size(); i += 3)
+    {
+        glm::dvec3 a = welded[positionOf[triangles[i]]], b = welded[positionOf[triangles[i + 1]]], c = welded[positionOf[triangles[i + 2]]];
+        glm::dvec3 n = glm::cross(b - a, c - a);
+        double length = glm::length(n);
+        if(length <= 0.0)
+            continue;
+        n /= length;
+        for(int k = 0; k < 3; k++)
+            quadrics[positionOf[triangles[i + k]]].addPlane(n, -glm::dot(n, a), 1.0);
+    }
+
+    EdgeSet edges;
+    edges.build(triangles, positionOf);
+    edges.forEach([&](uint32_t a, uint32_t b, size_t faces)
+    {
+        if(faces == 1)
+            border[a] = border[b] = 1;
+        else if(faces > 2)
+            locked[a] = locked[b] = 1;
+    });
+
+    // open borders get a plane perpendicular to the face through the border edge, so the outline resists moving inwards
+    for(size_t i = 0; i < triangles.size(); i += 3)
+    {
+        for(int k = 0; k < 3; k++)
+        {
+            uint32_t pa = positionOf[triangles[i + k]], pb = positionOf[triangles[i + (k + 1) % 3]];
+            if(!border[pa] || !border[pb] || edges.faceCount(pa, pb) != 1)
+                continue;
+            uint32_t pc = positionOf[triangles[i + (k + 2) % 3]];
+            glm::dvec3 a = welded[pa], b = welded[pb], c = welded[pc];
+            glm::dvec3 faceNormal = glm::cross(b - a, c - a);
+            glm::dvec3 n = glm::cross(b - a, faceNormal);
+            double length = glm::length(n);
+            if(length <= 0.0)
+                continue;
+            n /= length;
+            quadrics[pa].addPlane(n, -glm::dot(n, a), BORDER_WEIGHT);
+            quadrics[pb].addPlane(n, -glm::dot(n, a), BORDER_WEIGHT);
+        }
+    }
+
+    double maxCost = static_cast<double>(targetError) * targetError;
+    double resultCost = 0.0;
+    size_t targetTriangles = targetIndexCount / 3;
+
+    std::vector<uint32_t> adjacencyOffsets;
+    std::vector<uint32_t> adjacency;
+    std::vector<Collapse> collapses;
+    std::vector<uint8_t> touched;
+    std::vector<uint32_t> vertexRemap(vertexCount);
+    std::vector<std::pair<uint32_t, uint32_t>> copies;
+
+    // every pass picks the cheapest independent collapses, then rebuilds the topology
+    while(triangles.size() / 3 > targetTriangles)
+    {
+        size_t triangleCount = triangles.size() / 3;
+
+        adjacencyOffsets.assign(positionCount + 1, 0);
+        for(uint32_t index: triangles)
+            adjacencyOffsets[positionOf[index] + 1]++;
+        for(size_t i = 0; i < positionCount; i++)
+            adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+        adjacency.resize(triangles.size());
+        {
+            std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for(size_t i = 0; i < triangles.size(); i++)
+                adjacency[fill[positionOf[triangles[i]]]++] = static_cast<uint32_t>(i / 3);
+        }
+        edges.build(triangles, positionOf);
+
+        collapses.clear();
+        for(uint32_t from = 0; from < positionCount; from++)
+        {
+            if(locked[from] || adjacencyOffsets[from] == adjacencyOffsets[from + 1])
+                continue;
+            Collapse best{from, from, std::numeric_limits<double>::max()};
+            for(uint32_t t = adjacencyOffsets[from]; t < adjacencyOffsets[from + 1]; t++)
+            {
+                for(int k = 0; k < 3; k++)
+                {
+                    uint32_t to = positionOf[triangles[adjacency[t] * 3 + k]];
+                    if(to == from)
+                        continue;
+                    if(border[from] && (!border[to] || edges.faceCount(from, to) != 1))
+                        continue;
+                    double cost = quadrics[from].evaluate(welded[to]);
+                    if(cost < best.cost)
+                        best = {from, to, cost};
+                }
+            }
+            if(best.to != from)
+                collapses.push_back(best);
+        }
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b)
+        { return a.cost < b.cost || (a.cost == b.cost && a.from < b.from); });
+
+        touched.assign(positionCount, 0);
+        for(uint32_t i = 0; i < vertexCount; i++)
+            vertexRemap[i] = i;
+
+        size_t removed = 0;
+        for(const auto& collapse: collapses)
+        {
+            if(collapse.cost > maxCost || triangleCount - removed <= targetTriangles)
+                break;
+            if(touched[collapse.from] || touched[collapse.to])
+                continue;
+
+            // every attribute copy of the removed position moves to the copy of the kept position it shares a face with,
+            // a copy without such a face means the edge crosses a seam
+            copies.clear();
+            bool valid = true;
+            for(uint32_t t = adjacencyOffsets[collapse.from]; t < adjacencyOffsets[collapse.from + 1] && valid; t++)
+            {
+                const uint32_t* tri = &triangles[adjacency[t] * 3];
+                uint32_t target = UINT32_MAX;
+                for(int k = 0; k < 3; k++)
+                    if(positionOf[tri[k]] == collapse.to)
+                        target = tri[k];
+                for(int k = 0; k < 3; k++)
+                {
+                    if(positionOf[tri[k]] != collapse.from)
+                        continue;
+                    auto it = std::find_if(copies.begin(), copies.end(), [&](auto& copy)
+                    { return copy.first == tri[k]; });
+                    if(it == copies.end())
+                        copies.emplace_back(tri[k], target);
+                    else if(it->second == UINT32_MAX)
+                        it->second = target;
+                    else if(target != UINT32_MAX && it->second != target)
+                        valid = false;
+                }
+            }
+            for(const auto& copy: copies)
+                valid = valid && copy.second != UINT32_MAX;
+
+            // reject collapses that flip a remaining face
+            for(uint32_t t = adjacencyOffsets[collapse.from]; t < adjacencyOffsets[collapse.from + 1] && valid; t++)
+            {
+                const uint32_t* tri = &triangles[adjacency[t] * 3];
+                glm::vec3 before[3], after[3];
+                bool degenerate = false;
+                for(int k = 0; k < 3; k++)
+                {
+                    uint32_t p = positionOf[tri[k]];
+                    degenerate = degenerate || p == collapse.to;
+                    before[k] = welded[p];
+                    after[k] = p == collapse.from ? welded[collapse.to] : welded[p];
+                }
+                if(degenerate)
+                    continue;
+                glm::vec3 n0 = glm::cross(before[1] - before[0], before[2] - before[0]);
+                glm::vec3 n1 = glm::cross(after[1] - after[0], after[2] - after[0]);
+                if(glm::dot(n0, n1) <= 0.0f)
+                    valid = false;
+            }
+            if(!valid)
+                continue;
+
+            for(const auto& copy: copies)
+                vertexRemap[copy.first] = copy.second;
+            quadrics[collapse.to] += quadrics[collapse.from];
+            resultCost = std::max(resultCost, collapse.cost);
+
+            for(uint32_t t = adjacencyOffsets[collapse.from]; t < adjacencyOffsets[collapse.from + 1]; t++)
+            {
+                const uint32_t* tri = &triangles[adjacency[t] * 3];
+                bool shared = false;
+                for(int k = 0; k < 3; k++)
+                {
+                    touched[positionOf[tri[k]]] = 1;
+                    shared = shared || positionOf[tri[k]] == collapse.to;
+                }
+                removed += shared ? 1 : 0;
+            }
+        }
+        if(removed == 0)
+            break;
+
+        size_t write = 0;
+        for(size_t i = 0; i < triangles.size(); i += 3)
+        {
+            uint32_t a = vertexRemap[triangles[i]], b = vertexRemap[triangles[i + 1]], c = vertexRemap[triangles[i + 2]];
+            uint32_t pa = positionOf[a], pb = positionOf[b], pc = positionOf[c];
+            if(pa == pb || pb == pc || pa == pc)
+                continue;
+            triangles[write++] = a;
+            triangles[write++] = b;
+            triangles[write++] = c;
+        }
+        triangles.resize(write);
+    }
+
+    result.error = static_cast<float>(std::sqrt(resultCost));
+    return result;
+}
@@ -0,0 +1,122 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/mesh/HMeshlet.h"
+#include "../../include/core/Profiling.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <glm/glm.hpp>
+
+namespace
+{
+    glm::vec3 positionAt(const float* positions, size_t positionStride, uint32_t index)
+    {
+        glm::vec3 p;
+        std::memcpy(&p, reinterpret_cast<const std::byte*>(positions) + index * positionStride, sizeof(p));
+        return p;
+    }
+}
+
+std::vector<Hellion::HMeshlet> Hellion::HMeshletBuilder::build(std::span<const uint32_t> indices, const float* positions, size_t vertexCount,
+                                                               size_t positionStride)
+{
+    HELLION_ZONE_PROFILING()
+    std::vector<HMeshlet> meshlets;
+    // stamp of the last meshlet that referenced the vertex, avoids clearing a set for every meshlet
+    std::vector<uint32_t> stamp(vertexCount, 0);
+
+    auto newVertices = [&](size_t i, uint32_t id)
+    {
+        uint32_t count = 0;
+        for(size_t k = 0; k < 3; k++)
+        {
+            uint32_t v = indices[i + k];
+            bool repeated = (k > 0 && indices[i] == v) || (k > 1 && indices[i + 1] == v);
+            count += stamp[v] != id && !repeated ? 1 : 0;
+        }
+        return count;
+    };
+
+    HMeshlet current{};
+    uint32_t id = 1;
+    for(size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        uint32_t added = newVertices(i, id);
+        if(current.vertexCount + added > MAX_VERTICES || current.indexCount / 3 + 1 > MAX_TRIANGLES)
+        {
+            computeBounds(current, indices, positions, positionStride);
+            meshlets.push_back(current);
+            current = {};
+            current.indexOffset = static_cast<uint32_t>(i);
+            added = newVertices(i, ++id);
+        }
+
+        for(size_t k = 0; k < 3; k++)
+            stamp[indices[i + k]] = id;
+        current.vertexCount += added;
+        current.indexCount += 3;
+    }
+    if(current.indexCount > 0)
+    {
+        computeBounds(current, indices, positions, positionStride);
+        meshlets.push_back(current);
+    }
+    return meshlets;
+}
+
+void Hellion::HMeshletBuilder::computeBounds(HMeshlet& meshlet, std::span<const uint32_t> indices, const float* positions, size_t positionStride)
+{
+    auto range = indices.subspan(meshlet.indexOffset, meshlet.indexCount);
+
+    glm::vec3 min{std::numeric_limits<float>::max()}, max{std::numeric_limits<float>::lowest()};
+    for(uint32_t index: range)
+    {
+        auto p = positionAt(positions, positionStride, index);
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+    glm::vec3 center = (min + max) * 0.5f;
+    float radius = 0.0f;
+    for(uint32_t index: range)
+        radius = std::max(radius, glm::length(positionAt(positions, positionStride, index) - center));
+
+    std::vector<glm::vec3> normals;
+    normals.reserve(range.size() / 3);
+    glm::vec3 axis{0.0f};
+    for(size_t i = 0; i + 2 < range.size(); i += 3)
+    {
+        auto a = positionAt(positions, positionStride, range[i]);
+        auto b = positionAt(positions, positionStride, range[i + 1]);
+        auto c = positionAt(positions, positionStride, range[i + 2]);
+        glm::vec3 n = glm::cross(b - a, c - a);
+        float length = glm::length(n);
+        if(length <= 0.0f)
+            continue;
+        normals.push_back(n / length);
+        axis += n / length;
+    }
+
+    float coneCutoff = 1.0f;
+    float axisLength = glm::length(axis);
+    if(axisLength > 0.0f)
+    {
+        axis /= axisLength;
+        float minDot = 1.0f;
+        for(const auto& n: normals)
+            minDot = std::min(minDot, glm::dot(n, axis));
+        // a cone wider than ~84 degrees culls almost nothing and is not worth testing
+        if(minDot > 0.1f)
+            coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+
+    for(int k = 0; k < 3; k++)
+    {
+        meshlet.center[k] = center[k];
+        meshlet.coneAxis[k] = axis[k];
+    }
+    meshlet.radius = radius;
+    meshlet.coneCutoff = coneCutoff;
+}
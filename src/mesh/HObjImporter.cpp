@@ -0,0 +1,142 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/mesh/HObjImporter.h"
+#include "../../include/mesh/HVertexWelder.h"
+#include "../../include/core/HThreadPool.h"
+#include "../../include/core/Profiling.h"
+#include "tiny_obj_loader.h"
+#include <chrono>
+#include <fmt/core.h>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // multiple of 3 so chunks never split a triangle
+    constexpr size_t CHUNK_INDICES = 3 * 64 * 1024;
+
+    struct Chunk
+    {
+        const tinyobj::shape_t* shape;
+        size_t begin;
+        size_t end;
+
+        std::vector<Hellion::HVertex> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<uint32_t> remap;
+        size_t indexOffset;
+    };
+
+    float positiveZero(float value)
+    {
+        // -0.0f + 0.0f is +0.0f, keeps the bitwise welding from treating the two zeros as different vertices
+        return value + 0.0f;
+    }
+
+    double throughput(size_t triangles, Clock::duration time)
+    {
+        double seconds = std::chrono::duration<double>(time).count();
+        return seconds > 0.0 ? static_cast<double>(triangles) / seconds : 0.0;
+    }
+}
+
+Hellion::HMeshData Hellion::HObjImporter::import(const std::string& path)
+{
+    HELLION_ZONE_PROFILING()
+    auto parseStart = Clock::now();
+    tinyobj::attrib_t attrib;
+    std::vector<tinyobj::shape_t> shapes;
+    std::vector<tinyobj::material_t> materials;
+    std::string warn, err;
+
+    if(!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, path.c_str()))
+    {
+        throw std::runtime_error(warn + err);
+    }
+    auto parseTime = Clock::now() - parseStart;
+
+    auto weldStart = Clock::now();
+    std::vector<Chunk> chunks;
+    size_t totalIndices = 0;
+    for(const auto& shape: shapes)
+    {
+        size_t count = shape.mesh.indices.size();
+        for(size_t begin = 0; begin < count; begin += CHUNK_INDICES)
+            chunks.push_back({&shape, begin, std::min(count, begin + CHUNK_INDICES)});
+        totalIndices += count;
+    }
+
+    auto& pool = HThreadPool::global();
+
+    // every chunk welds its own vertices in parallel
+    pool.parallelFor(chunks.size(), 1, [&](size_t first, size_t last)
+    {
+        for(size_t c = first; c < last; c++)
+        {
+            auto& chunk = chunks[c];
+            size_t count = chunk.end - chunk.begin;
+            chunk.indices.resize(count);
+            HVertexWelder<HVertex> welder(chunk.vertices, count / 2);
+
+            for(size_t i = 0; i < count; i++)
+            {
+                const auto& index = chunk.shape->mesh.indices[chunk.begin + i];
+                HVertex vertex{};
+
+                vertex.pos = {
+                        positiveZero(attrib.vertices[3 * index.vertex_index + 0]),
+                        positiveZero(attrib.vertices[3 * index.vertex_index + 1]),
+                        positiveZero(attrib.vertices[3 * index.vertex_index + 2])
+                };
+
+                vertex.texCoord = {
+                        positiveZero(attrib.texcoords[2 * index.texcoord_index + 0]),
+                        positiveZero(1.0f - attrib.texcoords[2 * index.texcoord_index + 1])
+                };
+
+                vertex.color = {1.0f, 1.0f, 1.0f};
+
+                chunk.indices[i] = welder.insert(vertex);
+            }
+        }
+    });
+
+    // merging in chunk order keeps the first-occurrence vertex order of a serial import, the result does not depend on scheduling
+    HMeshData mesh;
+    size_t localVertexCount = 0;
+    for(const auto& chunk: chunks)
+        localVertexCount += chunk.vertices.size();
+
+    HVertexWelder<HVertex> welder(mesh.vertices, localVertexCount);
+    size_t indexOffset = 0;
+    for(auto& chunk: chunks)
+    {
+        chunk.remap.resize(chunk.vertices.size());
+        for(size_t i = 0; i < chunk.vertices.size(); i++)
+            chunk.remap[i] = welder.insert(chunk.vertices[i]);
+        chunk.indexOffset = indexOffset;
+        indexOffset += chunk.indices.size();
+        chunk.vertices = {};
+    }
+
+    mesh.indices.resize(totalIndices);
+    pool.parallelFor(chunks.size(), 1, [&](size_t first, size_t last)
+    {
+        for(size_t c = first; c < last; c++)
+        {
+            auto& chunk = chunks[c];
+            for(size_t i = 0; i < chunk.indices.size(); i++)
+                mesh.indices[chunk.indexOffset + i] = chunk.remap[chunk.indices[i]];
+        }
+    });
+    auto weldTime = Clock::now() - weldStart;
+
+    size_t triangles = totalIndices / 3;
+    fmt::println("imported {}: {} triangles, {} vertices, {} threads", path, triangles, mesh.vertices.size(), pool.getThreadCount() + 1);
+    fmt::println("  parse {:.2f} ms ({:.2f} Mtri/s), weld {:.2f} ms ({:.2f} Mtri/s)",
+                 std::chrono::duration<double, std::milli>(parseTime).count(), throughput(triangles, parseTime) / 1e6,
+                 std::chrono::duration<double, std::milli>(weldTime).count(), throughput(triangles, weldTime) / 1e6);
+    return mesh;
+}
@@ -0,0 +1,147 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/mesh/HVertexEncoding.h"
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <fmt/core.h>
+
+namespace
+{
+    template<class Vertex>
+    std::vector<vk::VertexInputAttributeDescription> attributes()
+    {
+        auto atr = Vertex::getAttributeDescriptions();
+        return {atr.begin(), atr.end()};
+    }
+
+    template<class F>
+    decltype(auto) dispatch(Hellion::HVertexFormat format, F&& f)
+    {
+        using namespace Hellion;
+        switch(format)
+        {
+            case HVertexFormat::PackedHalfUv:
+                return f(HVertexPacked<HUvFormat::Half, false>{});
+            case HVertexFormat::PackedUnormUv:
+                return f(HVertexPacked<HUvFormat::Unorm16, false>{});
+            case HVertexFormat::PackedHalfUvColor:
+                return f(HVertexPacked<HUvFormat::Half, true>{});
+            case HVertexFormat::PackedUnormUvColor:
+                return f(HVertexPacked<HUvFormat::Unorm16, true>{});
+            case HVertexFormat::Full:
+                break;
+        }
+        return f(HVertex{});
+    }
+
+    glm::vec2 octahedralEncode(glm::vec3 n)
+    {
+        n /= std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+        glm::vec2 p{n.x, n.y};
+        if(n.z < 0.0f)
+        {
+            glm::vec2 sign{p.x >= 0.0f ? 1.0f : -1.0f, p.y >= 0.0f ? 1.0f : -1.0f};
+            p = (1.0f - glm::abs(glm::vec2{p.y, p.x})) * sign;
+        }
+        return p;
+    }
+
+    bool uvsInUnitRange(const Hellion::HMeshData& mesh)
+    {
+        return std::all_of(mesh.vertices.begin(), mesh.vertices.end(), [](const Hellion::HVertex& vertex)
+        { return vertex.texCoord.x >= 0.0f && vertex.texCoord.x <= 1.0f && vertex.texCoord.y >= 0.0f && vertex.texCoord.y <= 1.0f; });
+    }
+
+    template<class Vertex>
+    void encodeVertex(const Hellion::HVertex& source, const glm::vec3& normal, const Hellion::HQuantization& quantization, Vertex& out)
+    {
+        glm::vec3 unorm = glm::clamp((source.pos - quantization.offset) / quantization.scale, 0.0f, 1.0f);
+        for(int i = 0; i < 3; i++)
+            out.position[i] = glm::packUnorm1x16(unorm[i]);
+        out.position[3] = 0;
+
+        glm::vec2 oct = glm::length(normal) > 0.0f ? octahedralEncode(normal) : glm::vec2(0.0f);
+        uint16_t x = glm::packSnorm1x16(oct.x);
+        uint16_t y = glm::packSnorm1x16(oct.y);
+        std::memcpy(&out.normal[0], &x, sizeof(x));
+        std::memcpy(&out.normal[1], &y, sizeof(y));
+
+        for(int i = 0; i < 2; i++)
+        {
+            if constexpr(Vertex::UV_FORMAT == Hellion::HUvFormat::Half)
+                out.texCoord[i] = glm::packHalf1x16(source.texCoord[i]);
+            else
+                out.texCoord[i] = glm::packUnorm1x16(source.texCoord[i]);
+        }
+
+        if constexpr(Vertex::HAS_COLOR)
+        {
+            uint32_t color = glm::packUnorm4x8(glm::vec4(source.color, 1.0f));
+            std::memcpy(out.color, &color, sizeof(color));
+        }
+    }
+}
+
+uint32_t Hellion::HVertexEncoding::stride(HVertexFormat format)
+{
+    return dispatch(format, [](auto vertex)
+    { return static_cast<uint32_t>(sizeof(vertex)); });
+}
+
+vk::VertexInputBindingDescription Hellion::HVertexEncoding::bindingDescription(HVertexFormat format)
+{
+    return dispatch(format, [](auto vertex)
+    { return decltype(vertex)::getBindingDescriptions(); });
+}
+
+std::vector<vk::VertexInputAttributeDescription> Hellion::HVertexEncoding::attributeDescriptions(HVertexFormat format)
+{
+    return dispatch(format, [](auto vertex)
+    { return attributes<decltype(vertex)>(); });
+}
+
+Hellion::HVertexFormat Hellion::HVertexEncoding::halfUvFormat(HVertexFormat format)
+{
+    switch(format)
+    {
+        case HVertexFormat::PackedUnormUv:
+            return HVertexFormat::PackedHalfUv;
+        case HVertexFormat::PackedUnormUvColor:
+            return HVertexFormat::PackedHalfUvColor;
+        default:
+            return format;
+    }
+}
+
+Hellion::HVertexFormat Hellion::HVertexEncoding::resolve(const HMeshData& mesh, HVertexFormat format)
+{
+    if(halfUvFormat(format) == format || uvsInUnitRange(mesh))
+        return format;
+    fmt::println("mesh uvs are outside [0, 1], encoding them as half instead of unorm16");
+    return halfUvFormat(format);
+}
+
+std::vector<std::byte> Hellion::HVertexEncoding::encode(const HMeshData& mesh, HVertexFormat format, const HQuantization& quantization)
+{
+    if(halfUvFormat(format) != format && !uvsInUnitRange(mesh))
+        throw std::runtime_error("failed to encode uvs outside [0, 1] as unorm16!");
+    return dispatch(format, [&](auto vertex)
+    {
+        using Vertex = decltype(vertex);
+        std::vector<std::byte> bytes(mesh.vertices.size() * sizeof(Vertex));
+        if constexpr(std::is_same_v<Vertex, HVertex>)
+        {
+            std::memcpy(bytes.data(), mesh.vertices.data(), bytes.size());
+        } else
+        {
+            auto out = reinterpret_cast<Vertex*>(bytes.data());
+            for(size_t i = 0; i < mesh.vertices.size(); i++)
+                encodeVertex(mesh.vertices[i], i < mesh.normals.size() ? mesh.normals[i] : glm::vec3(0.0f), quantization, out[i]);
+        }
+        return bytes;
+    });
+}
@@ -0,0 +1,88 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/texture/HKtx2.h"
+#include "../../include/core/Profiling.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+namespace
+{
+    constexpr uint8_t KTX2_IDENTIFIER[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+    struct Ktx2Header
+    {
+        uint8_t identifier[12];
+        uint32_t vkFormat;
+        uint32_t typeSize;
+        uint32_t pixelWidth;
+        uint32_t pixelHeight;
+        uint32_t pixelDepth;
+        uint32_t layerCount;
+        uint32_t faceCount;
+        uint32_t levelCount;
+        uint32_t supercompressionScheme;
+        uint32_t dfdByteOffset;
+        uint32_t dfdByteLength;
+        uint32_t kvdByteOffset;
+        uint32_t kvdByteLength;
+        uint64_t sgdByteOffset;
+        uint64_t sgdByteLength;
+    };
+    static_assert(sizeof(Ktx2Header) == 80);
+
+    struct Ktx2LevelIndex
+    {
+        uint64_t byteOffset;
+        uint64_t byteLength;
+        uint64_t uncompressedByteLength;
+    };
+}
+
+Hellion::HKtx2Texture::HKtx2Texture(const std::string& path)
+{
+    HELLION_ZONE_PROFILING()
+    if(!file.open(path) || file.getSize() < sizeof(Ktx2Header))
+        throw std::runtime_error("failed to open ktx2 texture!");
+
+    Ktx2Header header;
+    memcpy(&header, file.bytes().data(), sizeof(header));
+    if(memcmp(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0)
+        throw std::runtime_error("failed to read ktx2 texture, bad identifier!");
+    // basis universal (undefined format) and zstd need a transcoder, which is not part of the loader
+    if(header.vkFormat == 0 || header.supercompressionScheme != 0)
+        throw std::runtime_error("failed to read ktx2 texture, supercompressed data is not supported!");
+    if(header.pixelDepth > 1 || header.layerCount > 1 || header.faceCount != 1 || header.pixelHeight == 0)
+        throw std::runtime_error("failed to read ktx2 texture, only 2D textures are supported!");
+
+    format = static_cast<vk::Format>(header.vkFormat);
+    width = header.pixelWidth;
+    height = header.pixelHeight;
+    generateMips = header.levelCount == 0;
+
+    uint64_t indexEnd = sizeof(Ktx2Header) + static_cast<uint64_t>(std::max(header.levelCount, 1u)) * sizeof(Ktx2LevelIndex);
+    if(indexEnd > file.getSize())
+        throw std::runtime_error("failed to read ktx2 texture, truncated level index!");
+
+    auto index = file.bytes().subspan(sizeof(Ktx2Header));
+    // levelCount 0 stores only the base level and asks the loader to generate the rest
+    uint32_t levelCount = std::max(header.levelCount, 1u);
+    levels.reserve(levelCount);
+    for(uint32_t level = 0; level < levelCount; level++)
+    {
+        Ktx2LevelIndex entry;
+        memcpy(&entry, index.data() + level * sizeof(Ktx2LevelIndex), sizeof(entry));
+        if(entry.byteOffset + entry.byteLength > file.getSize())
+            throw std::runtime_error("failed to read ktx2 texture, level is out of the file!");
+        levels.push_back(HKtx2Level{std::max(width >> level, 1u), std::max(height >> level, 1u), entry.byteOffset, entry.byteLength});
+    }
+}
+
+bool Hellion::HKtx2Texture::isKtx2(const std::string& path)
+{
+    constexpr std::string_view extension = ".ktx2";
+    return path.size() >= extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
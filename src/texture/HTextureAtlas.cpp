@@ -0,0 +1,105 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#define STB_RECT_PACK_IMPLEMENTATION
+
+#include "../../include/texture/HTextureAtlas.h"
+#include "../../include/core/Profiling.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+Hellion::HTextureAtlas::HTextureAtlas(uint32_t pageSize, uint32_t padding, uint32_t mipLevels)
+        : pageSize{pageSize}, mipLevels{std::max(mipLevels, 1u)}
+{
+    cellSize = 1u << (this->mipLevels - 1);
+    this->padding = std::max(padding, cellSize);
+    if(pageSize % cellSize != 0)
+        throw std::runtime_error("failed to create texture atlas, page size is not a multiple of the mip alignment!");
+}
+
+std::vector<Hellion::HAtlasRegion> Hellion::HTextureAtlas::insert(std::span<const HAtlasImage> images)
+{
+    HELLION_ZONE_PROFILING()
+    uint32_t pageCells = pageSize / cellSize;
+    std::vector<stbrp_rect> rects(images.size());
+    for(size_t i = 0; i < images.size(); i++)
+    {
+        uint32_t width = (images[i].width + 2 * padding + cellSize - 1) / cellSize;
+        uint32_t height = (images[i].height + 2 * padding + cellSize - 1) / cellSize;
+        if(images[i].width == 0 || images[i].height == 0)
+            throw std::runtime_error("failed to insert into texture atlas, image is empty!");
+        if(width > pageCells || height > pageCells)
+            throw std::runtime_error("failed to insert into texture atlas, image is larger than a page!");
+        rects[i] = stbrp_rect{static_cast<int>(i), static_cast<stbrp_coord>(width), static_cast<stbrp_coord>(height), 0, 0, 0};
+    }
+
+    // the skyline of each page keeps its state, so the rects that did not fit are retried on the next page,
+    // a fresh page always takes at least one of them
+    std::vector<HAtlasRegion> regions(images.size());
+    std::vector<stbrp_rect> pending = rects;
+    for(uint32_t page = 0; !pending.empty(); page++)
+    {
+        if(page == pages.size())
+            addPage();
+        stbrp_pack_rects(packers[page].context.get(), pending.data(), static_cast<int>(pending.size()));
+
+        std::vector<stbrp_rect> rest;
+        for(const auto& rect: pending)
+        {
+            if(!rect.was_packed)
+            {
+                rest.push_back(rect);
+                continue;
+            }
+            const auto& image = images[rect.id];
+            uint32_t x = rect.x * cellSize + padding;
+            uint32_t y = rect.y * cellSize + padding;
+            blit(page, x, y, image);
+
+            auto& region = regions[rect.id];
+            region = HAtlasRegion{page, x, y, image.width, image.height};
+            region.uvMin[0] = static_cast<float>(x) / pageSize;
+            region.uvMin[1] = static_cast<float>(y) / pageSize;
+            region.uvMax[0] = static_cast<float>(x + image.width) / pageSize;
+            region.uvMax[1] = static_cast<float>(y + image.height) / pageSize;
+        }
+        pending = std::move(rest);
+    }
+    return regions;
+}
+
+void Hellion::HTextureAtlas::addPage()
+{
+    uint32_t pageCells = pageSize / cellSize;
+    Packer packer;
+    packer.context = std::make_unique<stbrp_context>();
+    packer.nodes.resize(pageCells);
+    stbrp_init_target(packer.context.get(), static_cast<int>(pageCells), static_cast<int>(pageCells), packer.nodes.data(),
+                      static_cast<int>(pageCells));
+    packers.push_back(std::move(packer));
+
+    HAtlasPage page;
+    page.pixels.resize(static_cast<size_t>(pageSize) * pageSize * 4, 0);
+    pages.push_back(std::move(page));
+}
+
+void Hellion::HTextureAtlas::blit(uint32_t page, uint32_t x, uint32_t y, const HAtlasImage& image)
+{
+    // the padding repeats the nearest edge texel, filtering across the border then only sees the image itself
+    auto& pixels = pages[page].pixels;
+    size_t stride = static_cast<size_t>(pageSize) * 4;
+    for(int64_t row = -static_cast<int64_t>(padding); row < static_cast<int64_t>(image.height + padding); row++)
+    {
+        int64_t sourceRow = std::clamp<int64_t>(row, 0, image.height - 1);
+        const uint8_t* source = image.rgba + sourceRow * image.width * 4;
+        uint8_t* dest = pixels.data() + (y + row) * stride + (x - padding) * 4;
+        for(uint32_t i = 0; i < padding; i++)
+            memcpy(dest + i * 4, source, 4);
+        memcpy(dest + padding * 4, source, static_cast<size_t>(image.width) * 4);
+        for(uint32_t i = 0; i < padding; i++)
+            memcpy(dest + (padding + image.width + i) * 4, source + (image.width - 1) * 4, 4);
+    }
+    pages[page].version++;
+}
@@ -0,0 +1,96 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/texture/HTextureCache.h"
+#include "../../include/core/HHash.h"
+#include "../../include/core/Profiling.h"
+#include <chrono>
+#include <cstring>
+#include <fmt/core.h>
+#include <stb_image.h>
+
+namespace
+{
+    uint64_t alignUp(uint64_t value, uint64_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+std::optional<Hellion::HMappedTexture> Hellion::HTextureCache::load(const std::string& cachePath, uint64_t sourceHash, HTextureCodec codec)
+{
+    HELLION_ZONE_PROFILING()
+    HMappedFile file;
+    if(!file.open(cachePath) || file.getSize() < sizeof(HTextureHeader))
+        return std::nullopt;
+
+    auto& header = *reinterpret_cast<const HTextureHeader*>(file.bytes().data());
+    if(header.magic != HTextureHeader::MAGIC || header.version != HTextureHeader::VERSION || header.sourceHash != sourceHash ||
+       header.codec != codec || header.levelCount == 0)
+        return std::nullopt;
+
+    uint64_t levelEnd = header.levelOffset + static_cast<uint64_t>(header.levelCount) * sizeof(HTextureLevel);
+    if(levelEnd > file.getSize() || header.dataOffset + header.dataSize > file.getSize())
+        return std::nullopt;
+
+    return HMappedTexture{std::move(file)};
+}
+
+std::vector<std::byte> Hellion::HTextureCache::serialize(const HTextureData& texture, uint64_t sourceHash)
+{
+    HELLION_ZONE_PROFILING()
+    HTextureHeader header{};
+    header.magic = HTextureHeader::MAGIC;
+    header.version = HTextureHeader::VERSION;
+    header.sourceHash = sourceHash;
+    header.codec = texture.codec;
+    header.width = texture.width;
+    header.height = texture.height;
+    header.levelCount = static_cast<uint32_t>(texture.levels.size());
+    header.levelOffset = alignUp(sizeof(HTextureHeader), 16);
+    header.dataOffset = alignUp(header.levelOffset + texture.levels.size() * sizeof(HTextureLevel), 16);
+    header.dataSize = texture.bytes.size();
+
+    // zero filled, so the alignment padding is deterministic
+    std::vector<std::byte> bytes(header.dataOffset + header.dataSize);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    if(!texture.levels.empty())
+        std::memcpy(bytes.data() + header.levelOffset, texture.levels.data(), texture.levels.size() * sizeof(HTextureLevel));
+    if(!texture.bytes.empty())
+        std::memcpy(bytes.data() + header.dataOffset, texture.bytes.data(), texture.bytes.size());
+    return bytes;
+}
+
+Hellion::HMappedTexture Hellion::HTextureCache::loadOrCompress(const std::string& sourcePath, HTextureCodec codec)
+{
+    HELLION_ZONE_PROFILING()
+    auto start = std::chrono::steady_clock::now();
+    auto cachePath = cachePathFor(sourcePath, codec);
+    auto hash = hashFileIdentity(sourcePath);
+
+    if(auto cached = load(cachePath, hash, codec))
+    {
+        fmt::println("texture {} loaded from cache in {:.2f} ms", sourcePath,
+                     std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        return std::move(*cached);
+    }
+
+    int width, height, channels;
+    stbi_uc* pixels = stbi_load(sourcePath.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    if(!pixels)
+        throw std::runtime_error("failed to load texture image!");
+    auto texture = HTextureCompressor::build(pixels, static_cast<uint32_t>(width), static_cast<uint32_t>(height), codec);
+    stbi_image_free(pixels);
+
+    auto bytes = serialize(texture, hash);
+    bool written = writeFileAtomically(cachePath, bytes);
+    fmt::println("texture {} compressed in {:.2f} ms, {} KiB", sourcePath,
+                 std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(), texture.bytes.size() / 1024);
+
+    // the mapping lets the OS page the texture out, the heap copy is only kept when the cache is unavailable
+    if(written)
+        if(auto cached = load(cachePath, hash, codec))
+            return std::move(*cached);
+    return HMappedTexture{std::move(bytes)};
+}
@@ -0,0 +1,187 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/texture/HTextureCompressor.h"
+#include "../../include/core/HThreadPool.h"
+#include "../../include/core/Profiling.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stb_image_resize.h>
+
+#define STB_DXT_IMPLEMENTATION
+
+#include <stb_dxt.h>
+
+namespace
+{
+    uint32_t blockBytes(Hellion::HTextureCodec codec)
+    {
+        using Hellion::HTextureCodec;
+        switch(codec)
+        {
+            case HTextureCodec::BC1:
+            case HTextureCodec::BC4:
+                return 8;
+            case HTextureCodec::BC3:
+            case HTextureCodec::BC5:
+                return 16;
+            case HTextureCodec::Rgba8:
+                break;
+        }
+        return 0;
+    }
+}
+
+vk::Format Hellion::HTextureCompressor::vulkanFormat(HTextureCodec codec)
+{
+    switch(codec)
+    {
+        case HTextureCodec::BC1:
+            return vk::Format::eBc1RgbSrgbBlock;
+        case HTextureCodec::BC3:
+            return vk::Format::eBc3SrgbBlock;
+        case HTextureCodec::BC4:
+            return vk::Format::eBc4UnormBlock;
+        case HTextureCodec::BC5:
+            return vk::Format::eBc5UnormBlock;
+        case HTextureCodec::Rgba8:
+            break;
+    }
+    return vk::Format::eR8G8B8A8Srgb;
+}
+
+uint64_t Hellion::HTextureCompressor::levelSize(HTextureCodec codec, uint32_t width, uint32_t height)
+{
+    if(codec == HTextureCodec::Rgba8)
+        return static_cast<uint64_t>(width) * height * 4;
+    // partial blocks at the edges are stored as whole blocks
+    return static_cast<uint64_t>((width + 3) / 4) * ((height + 3) / 4) * blockBytes(codec);
+}
+
+void Hellion::HTextureCompressor::compressBlock(HTextureCodec codec, const uint8_t* rgba, size_t stride, uint32_t x, uint32_t y, uint32_t width,
+                                                uint32_t height, std::byte* out)
+{
+    // texels outside a partial block repeat the edge, so the block endpoints are not pulled towards garbage
+    uint8_t block[16 * 4];
+    for(uint32_t by = 0; by < 4; by++)
+    {
+        for(uint32_t bx = 0; bx < 4; bx++)
+        {
+            uint32_t sx = std::min(x + bx, width - 1);
+            uint32_t sy = std::min(y + by, height - 1);
+            std::memcpy(&block[(by * 4 + bx) * 4], rgba + sy * stride + sx * 4, 4);
+        }
+    }
+
+    auto dest = reinterpret_cast<unsigned char*>(out);
+    switch(codec)
+    {
+        case HTextureCodec::BC1:
+            stb_compress_dxt_block(dest, block, 0, STB_DXT_HIGHQUAL);
+            break;
+        case HTextureCodec::BC3:
+            stb_compress_dxt_block(dest, block, 1, STB_DXT_HIGHQUAL);
+            break;
+        case HTextureCodec::BC4:
+        {
+            uint8_t r[16];
+            for(int i = 0; i < 16; i++)
+                r[i] = block[i * 4];
+            stb_compress_bc4_block(dest, r);
+            break;
+        }
+        case HTextureCodec::BC5:
+        {
+            uint8_t rg[32];
+            for(int i = 0; i < 16; i++)
+            {
+                rg[i * 2] = block[i * 4];
+                rg[i * 2 + 1] = block[i * 4 + 1];
+            }
+            stb_compress_bc5_block(dest, rg);
+            break;
+        }
+        case HTextureCodec::Rgba8:
+            break;
+    }
+}
+
+std::vector<std::vector<uint8_t>> Hellion::HTextureCompressor::generateMipChain(const uint8_t* rgba, uint32_t width, uint32_t height, bool srgb)
+{
+    HELLION_ZONE_PROFILING()
+    uint32_t levelCount = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+    std::vector<std::vector<uint8_t>> mips(levelCount);
+    mips[0].assign(rgba, rgba + static_cast<size_t>(width) * height * 4);
+
+    // every level is filtered from the previous one, filtering small levels straight from level 0 costs as much as level 1
+    for(uint32_t level = 1; level < levelCount; level++)
+    {
+        int srcWidth = static_cast<int>(std::max(width >> (level - 1), 1u));
+        int srcHeight = static_cast<int>(std::max(height >> (level - 1), 1u));
+        int dstWidth = static_cast<int>(std::max(width >> level, 1u));
+        int dstHeight = static_cast<int>(std::max(height >> level, 1u));
+        mips[level].resize(static_cast<size_t>(dstWidth) * dstHeight * 4);
+        if(srgb)
+            stbir_resize_uint8_srgb(mips[level - 1].data(), srcWidth, srcHeight, 0, mips[level].data(), dstWidth, dstHeight, 0, 4, 3, 0);
+        else
+            stbir_resize_uint8(mips[level - 1].data(), srcWidth, srcHeight, 0, mips[level].data(), dstWidth, dstHeight, 0, 4);
+    }
+    return mips;
+}
+
+Hellion::HTextureData Hellion::HTextureCompressor::build(const uint8_t* rgba, uint32_t width, uint32_t height, HTextureCodec codec)
+{
+    HELLION_ZONE_PROFILING()
+    HTextureData result;
+    result.codec = codec;
+    result.width = width;
+    result.height = height;
+
+    uint32_t levelCount = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+    uint64_t size = 0;
+    for(uint32_t level = 0; level < levelCount; level++)
+    {
+        uint32_t w = std::max(width >> level, 1u);
+        uint32_t h = std::max(height >> level, 1u);
+        uint64_t levelBytes = levelSize(codec, w, h);
+        result.levels.push_back({w, h, size, levelBytes});
+        size += levelBytes;
+    }
+    result.bytes.resize(size);
+
+    // BC4/BC5 hold linear data, only the color codecs are filtered in sRGB space
+    bool srgb = codec != HTextureCodec::BC4 && codec != HTextureCodec::BC5;
+    auto mips = generateMipChain(rgba, width, height, srgb);
+    auto& pool = HThreadPool::global();
+
+    if(codec == HTextureCodec::Rgba8)
+    {
+        for(uint32_t level = 0; level < levelCount; level++)
+            std::memcpy(result.bytes.data() + result.levels[level].offset, mips[level].data(), result.levels[level].size);
+        return result;
+    }
+
+    // one work item per block row of any level, so small levels do not serialize behind the large ones
+    std::vector<std::pair<uint32_t, uint32_t>> rows;
+    for(uint32_t level = 0; level < levelCount; level++)
+        for(uint32_t row = 0; row < (result.levels[level].height + 3) / 4; row++)
+            rows.emplace_back(level, row);
+
+    uint32_t bytesPerBlock = blockBytes(codec);
+    pool.parallelFor(rows.size(), 8, [&](size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end; i++)
+        {
+            auto [level, row] = rows[i];
+            const auto& info = result.levels[level];
+            uint32_t blocksPerRow = (info.width + 3) / 4;
+            std::byte* out = result.bytes.data() + info.offset + static_cast<uint64_t>(row) * blocksPerRow * bytesPerBlock;
+            for(uint32_t block = 0; block < blocksPerRow; block++)
+                compressBlock(codec, mips[level].data(), static_cast<size_t>(info.width) * 4, block * 4, row * 4, info.width, info.height,
+                              out + block * bytesPerBlock);
+        }
+    });
+    return result;
+}
@@ -3,11 +3,13 @@
 //
 
 #include "../../include/vulkan/CanvasSystem.h"
+#include "../../include/core/HAllocationTracker.h"
 
 
 void Hellion::CanvasSystem::draw(vk::CommandBuffer& buffer, uint32_t currentFrame, tracy::VkCtx* tracyCtx)
 {
     HELLION_ZONE_PROFILING()
+    HELLION_NO_ALLOCATION_SCOPE("CanvasSystem::draw")
     HELLION_GPUZONE_PROFILING(tracyCtx, buffer, "Canvas draw")
     pipeline->bind(buffer);
 
@@ -4,6 +4,44 @@
 
 #include "../../include/vulkan/HBuffer.h"
 
-namespace Hellion
+void Hellion::HBuffer::enableDefragmentation()
 {
-} // Hellion
\ No newline at end of file
+    device.getDefragmenter().track(allocation, this);
+}
+
+void Hellion::HBuffer::recordMove(vk::CommandBuffer commandBuffer, VmaAllocation dstAllocation)
+{
+    HELLION_ZONE_PROFILING()
+    vk::BufferCreateInfo bufferInfo = {};
+    bufferInfo.size = bufferSize;
+    bufferInfo.usage = usageFlags;
+    bufferInfo.sharingMode = vk::SharingMode::eExclusive;
+    uint32_t families[] = {device.getGraphicsFamily(), device.getComputeFamily()};
+    if(shareWithCompute && families[0] != families[1])
+    {
+        bufferInfo.sharingMode = vk::SharingMode::eConcurrent;
+        bufferInfo.queueFamilyIndexCount = 2;
+        bufferInfo.pQueueFamilyIndices = families;
+    }
+    vk::Buffer newBuffer = device.getDevice().createBuffer(bufferInfo);
+    if(vmaBindBufferMemory(device.getAllocator(), dstAllocation, newBuffer) != VK_SUCCESS)
+        throw std::runtime_error("failed to bind moved buffer memory!");
+
+    // earlier frames and uploads may still use the old buffer
+    vk::MemoryBarrier before{vk::AccessFlagBits::eMemoryWrite, vk::AccessFlagBits::eTransferRead};
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eTransfer, {}, before, {}, {});
+    commandBuffer.copyBuffer(buffer, newBuffer, vk::BufferCopy{0, 0, bufferSize});
+    vk::MemoryBarrier after{vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite};
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eAllCommands, {}, after, {}, {});
+
+    movedBuffer = buffer;
+    buffer = newBuffer;
+}
+
+void Hellion::HBuffer::finishMove()
+{
+    device.getDevice().destroyBuffer(movedBuffer);
+    movedBuffer = VK_NULL_HANDLE;
+    // VMA keeps persistently mapped allocations mapped at their new place
+    vmaGetAllocationInfo(device.getAllocator(), allocation, &info);
+}
@@ -0,0 +1,206 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/vulkan/HDefragmenter.h"
+#include "../../include/vulkan/HDevice.h"
+#include "../../include/core/HAllocationTracker.h"
+#include <limits>
+
+void Hellion::HDefragmenter::init(HDevice& device, VmaPool texturePool)
+{
+    this->device = &device;
+    this->allocator = device.getAllocator();
+    this->texturePool = texturePool;
+}
+
+void Hellion::HDefragmenter::destroy()
+{
+    if(commandBuffer)
+    {
+        (void) device->getDevice().waitForFences(fence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+        endPass();
+    }
+    if(context)
+        endSession();
+    if(fence)
+        device->getDevice().destroy(fence);
+    fence = nullptr;
+}
+
+void Hellion::HDefragmenter::update()
+{
+    HELLION_ZONE_PROFILING()
+    HELLION_ALLOCATION_SCOPE("HDefragmenter::update")
+    frame++;
+    if(commandBuffer)
+    {
+        if(device->getDevice().getFenceStatus(fence) != vk::Result::eSuccess)
+            return;
+        endPass();
+        return;
+    }
+
+    if(!context)
+    {
+        VmaPool pool;
+        if(!enabled || frame % CHECK_INTERVAL != 0 || !pickPool(pool))
+            return;
+        beginSession(pool);
+    }
+    recordPass();
+}
+
+void Hellion::HDefragmenter::track(VmaAllocation allocation, HMovable* resource)
+{
+    vmaSetAllocationUserData(allocator, allocation, resource);
+}
+
+bool Hellion::HDefragmenter::release(VmaAllocation allocation)
+{
+    if(!commandBuffer)
+        return false;
+    // ignored moves still reference their allocation until the pass ends, so they are handed to the pass as well
+    for(uint32_t i = 0; i < pass.moveCount; i++)
+    {
+        auto& move = pass.pMoves[i];
+        if(move.srcAllocation == allocation)
+        {
+            move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_DESTROY;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Hellion::HDefragmenter::pickPool(VmaPool& pool)
+{
+    auto worthCompacting = [](vk::DeviceSize blockBytes, vk::DeviceSize allocationBytes)
+    {
+        vk::DeviceSize wasted = blockBytes - allocationBytes;
+        return wasted >= MIN_WASTED_BYTES && wasted >= static_cast<vk::DeviceSize>(blockBytes * MIN_WASTED_RATIO);
+    };
+
+    VmaTotalStatistics total;
+    vmaCalculateStatistics(allocator, &total);
+    VmaStatistics poolStats{};
+    if(texturePool)
+        vmaGetPoolStatistics(allocator, texturePool, &poolStats);
+
+    // the totals include the custom pool, what is left are the default pools
+    vk::DeviceSize defaultBlockBytes = total.total.statistics.blockBytes - poolStats.blockBytes;
+    vk::DeviceSize defaultAllocationBytes = total.total.statistics.allocationBytes - poolStats.allocationBytes;
+    bool compactPool = texturePool && worthCompacting(poolStats.blockBytes, poolStats.allocationBytes);
+    bool compactDefault = worthCompacting(defaultBlockBytes, defaultAllocationBytes);
+    if(!compactPool && !compactDefault)
+        return false;
+
+    if(compactPool && compactDefault)
+        pool = poolStats.blockBytes - poolStats.allocationBytes >= defaultBlockBytes - defaultAllocationBytes ? texturePool : VK_NULL_HANDLE;
+    else
+        pool = compactPool ? texturePool : VK_NULL_HANDLE;
+    return true;
+}
+
+void Hellion::HDefragmenter::beginSession(VmaPool pool)
+{
+    VmaDefragmentationInfo info = {};
+    info.flags = VMA_DEFRAGMENTATION_FLAG_ALGORITHM_BALANCED_BIT;
+    info.pool = pool;
+    info.maxBytesPerPass = MAX_BYTES_PER_PASS;
+    info.maxAllocationsPerPass = MAX_MOVES_PER_PASS;
+    if(vmaBeginDefragmentation(allocator, &info, &context) != VK_SUCCESS)
+        throw std::runtime_error("failed to begin defragmentation!");
+    stats.running = true;
+}
+
+void Hellion::HDefragmenter::recordPass()
+{
+    HELLION_ZONE_PROFILING()
+    if(vmaBeginDefragmentationPass(allocator, context, &pass) == VK_SUCCESS)
+    {
+        // nothing left to move
+        endSession();
+        return;
+    }
+
+    vk::CommandBufferAllocateInfo allocInfo{};
+    allocInfo.level = vk::CommandBufferLevel::ePrimary;
+    allocInfo.commandPool = device->getCommandPool();
+    allocInfo.commandBufferCount = 1;
+    commandBuffer = device->getDevice().allocateCommandBuffers(allocInfo)[0];
+    commandBuffer.begin(vk::CommandBufferBeginInfo{vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+
+    for(uint32_t i = 0; i < pass.moveCount; i++)
+    {
+        auto& move = pass.pMoves[i];
+        VmaAllocationInfo info;
+        vmaGetAllocationInfo(allocator, move.srcAllocation, &info);
+        auto resource = static_cast<HMovable*>(info.pUserData);
+        if(!resource)
+        {
+            // nobody to rebind, the allocation stays where it is
+            move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+            continue;
+        }
+        resource->recordMove(commandBuffer, move.dstTmpAllocation);
+    }
+    commandBuffer.end();
+
+    if(!fence)
+        fence = device->getDevice().createFence(vk::FenceCreateInfo{});
+    device->getDevice().resetFences(fence);
+    vk::SubmitInfo submitInfo{};
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+    device->getGraphicsQueue().submit(submitInfo, fence);
+}
+
+void Hellion::HDefragmenter::endPass()
+{
+    HELLION_ZONE_PROFILING()
+    for(uint32_t i = 0; i < pass.moveCount; i++)
+    {
+        auto& move = pass.pMoves[i];
+        if(move.operation != VMA_DEFRAGMENTATION_MOVE_OPERATION_COPY)
+            continue;
+        VmaAllocationInfo info;
+        vmaGetAllocationInfo(allocator, move.srcAllocation, &info);
+        static_cast<HMovable*>(info.pUserData)->finishMove();
+    }
+    // the fence signaled, the copies are done with the handles of resources freed during the pass
+    for(auto view: retiredViews)
+        device->getDevice().destroy(view);
+    for(auto image: retiredImages)
+        device->getDevice().destroyImage(image);
+    for(auto buffer: retiredBuffers)
+        device->getDevice().destroyBuffer(buffer);
+    retiredViews.clear();
+    retiredImages.clear();
+    retiredBuffers.clear();
+    device->getDevice().freeCommandBuffers(device->getCommandPool(), commandBuffer);
+    commandBuffer = nullptr;
+    stats.passes++;
+
+    if(vmaEndDefragmentationPass(allocator, context, &pass) == VK_SUCCESS)
+        endSession();
+}
+
+void Hellion::HDefragmenter::endSession()
+{
+    VmaDefragmentationStats sessionStats = {};
+    vmaEndDefragmentation(allocator, context, &sessionStats);
+    context = VK_NULL_HANDLE;
+    pass = {};
+
+    stats.bytesMoved += sessionStats.bytesMoved;
+    stats.bytesFreed += sessionStats.bytesFreed;
+    stats.allocationsMoved += sessionStats.allocationsMoved;
+    stats.blocksFreed += sessionStats.deviceMemoryBlocksFreed;
+    stats.sessions++;
+    stats.running = false;
+    if(sessionStats.allocationsMoved > 0)
+        fmt::println("defragmentation moved {} allocations ({:.1f} MB), freed {} blocks ({:.1f} MB)", sessionStats.allocationsMoved,
+                     sessionStats.bytesMoved / (1024.0 * 1024.0), sessionStats.deviceMemoryBlocksFreed,
+                     sessionStats.bytesFreed / (1024.0 * 1024.0));
+}
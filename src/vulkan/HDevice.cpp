@@ -162,6 +162,11 @@ void Hellion::HDevice::pickPhysicalDevice()
             break;
         }
     }
+
+    // queried once, they do not change for the lifetime of the device
+    properties = physicalDevice.getProperties();
+    features = physicalDevice.getFeatures();
+    memoryProperties = physicalDevice.getMemoryProperties();
 }
 
 Hellion::QueueFamilyIndices Hellion::HDevice::findQueueFamilies(const vk::PhysicalDevice& device)
@@ -173,17 +178,23 @@ Hellion::QueueFamilyIndices Hellion::HDevice::findQueueFamilies(const vk::Physic
     int i = 0;
     for(const auto& queueFamily: queueFamilies)
     {
-        if(queueFamily.queueCount > 0 && queueFamily.queueFlags & vk::QueueFlagBits::eGraphics)
+        if(!indices.graphicsFamily && queueFamily.queueCount > 0 && queueFamily.queueFlags & vk::QueueFlagBits::eGraphics)
             indices.graphicsFamily = i;
 
-        if(queueFamily.queueCount > 0 && device.getSurfaceSupportKHR(i, surface))
+        if(!indices.presentFamily && queueFamily.queueCount > 0 && device.getSurfaceSupportKHR(i, surface))
             indices.presentFamily = i;
 
-        if(indices.isComplete())
-            break;
+        // prefer a compute-only family, it maps to the async compute engine on most hardware
+        if(!indices.hasDedicatedCompute() && queueFamily.queueCount > 0 && queueFamily.queueFlags & vk::QueueFlagBits::eCompute &&
+           !(queueFamily.queueFlags & vk::QueueFlagBits::eGraphics))
+            indices.computeFamily = i;
         i++;
     }
 
+    // a graphics family always supports compute
+    if(!indices.computeFamily)
+        indices.computeFamily = indices.graphicsFamily;
+
     return indices;
 }
 
@@ -223,7 +234,15 @@ bool Hellion::HDevice::isDeviceSuitable(const vk::PhysicalDevice& device)
 
     auto supportedFeatures = device.getFeatures();
 
-    return indices.isComplete() && extensionsSupported && swapChainAdequate && supportedFeatures.samplerAnisotropy;
+    // the frame timeline semaphore is core in 1.2, the Vulkan12Features struct can't be chained on an older device
+    bool timelineSemaphore = false;
+    if(device.getProperties().apiVersion >= VK_API_VERSION_1_2)
+    {
+        auto features12 = device.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features>();
+        timelineSemaphore = features12.get<vk::PhysicalDeviceVulkan12Features>().timelineSemaphore;
+    }
+
+    return indices.isComplete() && extensionsSupported && swapChainAdequate && supportedFeatures.samplerAnisotropy && timelineSemaphore;
 }
 
 void Hellion::HDevice::createLogicalDevice()
@@ -231,21 +250,65 @@ void Hellion::HDevice::createLogicalDevice()
     QueueFamilyIndices indices = findQueueFamilies(physicalDevice);
 
     std::vector<vk::DeviceQueueCreateInfo> queueCreateInfos;
-    std::set<uint32_t> uniqueQueueFamilies = {indices.graphicsFamily.value(), indices.presentFamily.value()};
+    std::set<uint32_t> uniqueQueueFamilies = {indices.graphicsFamily.value(), indices.presentFamily.value(), indices.computeFamily.value()};
+
+    // without a dedicated compute family, try to take a second queue from the graphics family
+    auto queueFamilies = physicalDevice.getQueueFamilyProperties();
+    uint32_t computeQueueIndex = 0;
+    if(!indices.hasDedicatedCompute() && queueFamilies[indices.graphicsFamily.value()].queueCount > 1)
+        computeQueueIndex = 1;
 
-    float queuePriority = 1.0f;
+    float queuePriorities[] = {1.0f, 1.0f};
 
     for(uint32_t queueFamily: uniqueQueueFamilies)
-        queueCreateInfos.push_back({vk::DeviceQueueCreateFlags(), queueFamily, 1, &queuePriority});
+    {
+        uint32_t queueCount = queueFamily == indices.graphicsFamily.value() ? computeQueueIndex + 1 : 1;
+        queueCreateInfos.push_back({vk::DeviceQueueCreateFlags(), queueFamily, queueCount, queuePriorities});
+    }
 
     auto deviceFeatures = vk::PhysicalDeviceFeatures();
     deviceFeatures.samplerAnisotropy = VK_TRUE;
     deviceFeatures.geometryShader = VK_TRUE;
+    multiDrawIndirectSupported = features.multiDrawIndirect;
+    deviceFeatures.multiDrawIndirect = multiDrawIndirectSupported;
+    pipelineStatisticsSupported = features.pipelineStatisticsQuery;
+    deviceFeatures.pipelineStatisticsQuery = pipelineStatisticsSupported;
+
+    vk::PhysicalDeviceVulkan12Features deviceFeatures12{};
+    deviceFeatures12.timelineSemaphore = VK_TRUE;
+
+    std::vector<const char*> extensions = deviceExtensions;
+    std::set<std::string> available;
+    for(const auto& extension: physicalDevice.enumerateDeviceExtensionProperties())
+        available.insert(extension.extensionName);
+    for(const char* extension: optionalDeviceExtensions)
+        if(available.contains(extension))
+            extensions.push_back(extension);
+    enabledExtensions = std::set<std::string>(extensions.begin(), extensions.end());
+
+    vk::PhysicalDevicePresentIdFeaturesKHR presentIdFeatures{};
+    vk::PhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures{};
+    // the extension feature structs may only be chained when the device supports their extensions
+    if(isExtensionEnabled(VK_KHR_PRESENT_ID_EXTENSION_NAME) && isExtensionEnabled(VK_KHR_PRESENT_WAIT_EXTENSION_NAME))
+    {
+        auto supportedFeatures = physicalDevice.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDevicePresentIdFeaturesKHR,
+                vk::PhysicalDevicePresentWaitFeaturesKHR>();
+        presentWaitSupported = supportedFeatures.get<vk::PhysicalDevicePresentIdFeaturesKHR>().presentId &&
+                               supportedFeatures.get<vk::PhysicalDevicePresentWaitFeaturesKHR>().presentWait;
+    }
+    if(presentWaitSupported)
+    {
+        presentIdFeatures.presentId = VK_TRUE;
+        presentWaitFeatures.presentWait = VK_TRUE;
+        presentIdFeatures.pNext = &presentWaitFeatures;
+        deviceFeatures12.pNext = &presentIdFeatures;
+    }
 
     auto createInfo = vk::DeviceCreateInfo(vk::DeviceCreateFlags(), static_cast<uint32_t>(queueCreateInfos.size()), queueCreateInfos.data());
     createInfo.pEnabledFeatures = &deviceFeatures;
-    createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
-    createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+    createInfo.pNext = &deviceFeatures12;
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    createInfo.ppEnabledExtensionNames = extensions.data();
 
     if(enableValidationLayers)
     {
@@ -264,6 +327,11 @@ void Hellion::HDevice::createLogicalDevice()
 
     graphicsQueue = device.getQueue(indices.graphicsFamily.value(), 0);
     presentQueue = device.getQueue(indices.presentFamily.value(), 0);
+    computeQueue = device.getQueue(indices.computeFamily.value(), computeQueueIndex);
+    computeFamilyIndex = indices.computeFamily.value();
+    graphicsFamilyIndex = indices.graphicsFamily.value();
+
+    dldi.init(device);
 }
 
 void Hellion::HDevice::createVmaAllocator()
@@ -273,8 +341,192 @@ void Hellion::HDevice::createVmaAllocator()
     allocatorInfo.device = device;
     allocatorInfo.instance = instance;
     allocatorInfo.vulkanApiVersion = GetVulkanApiVersion();
+    if(hasMemoryBudget())
+        allocatorInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+    allocatorInfo.pDeviceMemoryCallbacks = HAllocationTracker::deviceMemoryCallbacks();
 
     vmaCreateAllocator(&allocatorInfo, &g_hAllocator);
+    createTexturePool();
+    defragmenter.init(*this, texturePool);
+}
+
+void Hellion::HDevice::createTexturePool()
+{
+    for(uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++)
+        if(memoryProperties.memoryTypes[i].propertyFlags & vk::MemoryPropertyFlagBits::eLazilyAllocated)
+            lazilyAllocatedSupported = true;
+
+    // a representative texture picks the memory type, images whose requirements end up elsewhere skip the pool
+    vk::ImageCreateInfo imageInfo{};
+    imageInfo.imageType = vk::ImageType::e2D;
+    imageInfo.extent = vk::Extent3D{1024, 1024, 1};
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.format = vk::Format::eR8G8B8A8Srgb;
+    imageInfo.tiling = vk::ImageTiling::eOptimal;
+    imageInfo.initialLayout = vk::ImageLayout::eUndefined;
+    imageInfo.usage = vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled;
+    imageInfo.samples = vk::SampleCountFlagBits::e1;
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+    if(vmaFindMemoryTypeIndexForImageInfo(g_hAllocator, reinterpret_cast<VkImageCreateInfo*>(&imageInfo), &allocInfo, &texturePoolMemoryType) !=
+       VK_SUCCESS)
+        return;
+
+    VmaPoolCreateInfo poolInfo = {};
+    poolInfo.memoryTypeIndex = texturePoolMemoryType;
+    poolInfo.blockSize = TEXTURE_POOL_BLOCK_SIZE;
+    if(vmaCreatePool(g_hAllocator, &poolInfo, &texturePool) != VK_SUCCESS)
+        texturePool = VK_NULL_HANDLE;
+}
+
+VmaAllocationCreateInfo Hellion::HDevice::imageAllocationInfo(const vk::ImageCreateInfo& imageInfo)
+{
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+
+    if(imageInfo.usage & vk::ImageUsageFlagBits::eTransientAttachment && lazilyAllocatedSupported)
+    {
+        allocInfo.usage = VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED;
+        allocInfo.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+        imageCounts.lazyImages++;
+        return allocInfo;
+    }
+
+    bool attachment = static_cast<bool>(imageInfo.usage & (vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eDepthStencilAttachment));
+    vk::DeviceSize texels = static_cast<vk::DeviceSize>(imageInfo.extent.width) * imageInfo.extent.height * imageInfo.extent.depth *
+                            imageInfo.arrayLayers * static_cast<uint32_t>(imageInfo.samples);
+    if(attachment && texels >= DEDICATED_IMAGE_TEXELS)
+    {
+        allocInfo.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+        allocInfo.priority = 1.0f;
+        imageCounts.dedicatedImages++;
+        return allocInfo;
+    }
+
+    if(!attachment && texturePool && imageInfo.usage & vk::ImageUsageFlagBits::eSampled)
+    {
+        uint32_t memoryType;
+        VmaAllocationCreateInfo poolProbe = {};
+        poolProbe.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+        if(vmaFindMemoryTypeIndexForImageInfo(g_hAllocator, reinterpret_cast<const VkImageCreateInfo*>(&imageInfo), &poolProbe, &memoryType) ==
+           VK_SUCCESS && memoryType == texturePoolMemoryType)
+        {
+            allocInfo.pool = texturePool;
+            allocInfo.priority = 0.5f;
+            imageCounts.pooledImages++;
+            return allocInfo;
+        }
+    }
+
+    allocInfo.priority = attachment ? 1.0f : 0.5f;
+    imageCounts.defaultImages++;
+    return allocInfo;
+}
+
+std::pair<vk::Image, VmaAllocation> Hellion::HDevice::createImageWithInfo(vk::ImageCreateInfo& imageInfo)
+{
+    HELLION_ZONE_PROFILING()
+    VmaAllocationCreateInfo allocCreateInfo = imageAllocationInfo(imageInfo);
+    vk::Image img;
+    VmaAllocation alloc;
+    if(vmaCreateImage(g_hAllocator, reinterpret_cast<VkImageCreateInfo*>(&imageInfo), &allocCreateInfo, reinterpret_cast<VkImage*>(&img), &alloc,
+                      nullptr) != VK_SUCCESS)
+        throw std::runtime_error("failed to allocate image memory!");
+    trackAllocation(alloc, allocationCategory(imageInfo.usage));
+    return {img, alloc};
+}
+
+void Hellion::HDevice::trackAllocation(VmaAllocation allocation, const char* category)
+{
+    vmaSetAllocationName(g_hAllocator, allocation, category);
+    VmaAllocationInfo info;
+    vmaGetAllocationInfo(g_hAllocator, allocation, &info);
+    std::lock_guard lock(categoryMutex);
+    auto& usage = categoryUsage[category];
+    usage.bytes += info.size;
+    usage.allocations++;
+}
+
+void Hellion::HDevice::releaseAllocation(VmaAllocation allocation)
+{
+    if(!allocation)
+        return;
+    VmaAllocationInfo info;
+    vmaGetAllocationInfo(g_hAllocator, allocation, &info);
+    if(!info.pName)
+        return;
+    std::lock_guard lock(categoryMutex);
+    auto usage = categoryUsage.find(std::string_view(info.pName));
+    if(usage == categoryUsage.end())
+        return;
+    usage->second.bytes -= info.size;
+    usage->second.allocations--;
+}
+
+std::map<std::string, Hellion::HCategoryUsage> Hellion::HDevice::getCategoryUsage() const
+{
+    std::lock_guard lock(categoryMutex);
+    return {categoryUsage.begin(), categoryUsage.end()};
+}
+
+const char* Hellion::HDevice::allocationCategory(vk::BufferUsageFlags usage, VmaAllocationCreateFlags flags)
+{
+    if(flags & (VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT) &&
+       usage & vk::BufferUsageFlagBits::eTransferSrc)
+        return "staging";
+    if(usage & (vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer))
+        return "geometry";
+    if(usage & vk::BufferUsageFlagBits::eUniformBuffer)
+        return "uniform";
+    if(usage & (vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer))
+        return "storage";
+    return "other buffer";
+}
+
+const char* Hellion::HDevice::allocationCategory(vk::ImageUsageFlags usage)
+{
+    if(usage & (vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eDepthStencilAttachment))
+        return "render target";
+    if(usage & vk::ImageUsageFlagBits::eSampled)
+        return "texture";
+    return "other image";
+}
+
+Hellion::HAllocationStats Hellion::HDevice::getAllocationStats()
+{
+    VmaTotalStatistics total;
+    vmaCalculateStatistics(g_hAllocator, &total);
+
+    HAllocationStats stats = imageCounts;
+    stats.memoryBlocks = total.total.statistics.blockCount;
+    stats.allocations = total.total.statistics.allocationCount;
+    stats.blockBytes = total.total.statistics.blockBytes;
+    stats.allocationBytes = total.total.statistics.allocationBytes;
+    stats.maxMemoryAllocations = properties.limits.maxMemoryAllocationCount;
+    if(texturePool)
+    {
+        VmaStatistics poolStats;
+        vmaGetPoolStatistics(g_hAllocator, texturePool, &poolStats);
+        stats.texturePoolBlocks = poolStats.blockCount;
+        stats.texturePoolAllocations = poolStats.allocationCount;
+    }
+    return stats;
+}
+
+void Hellion::HDevice::printAllocationStats()
+{
+    auto stats = getAllocationStats();
+    fmt::println("device memory: {} blocks of {} allowed, {} allocations, {:.1f} MB used of {:.1f} MB allocated", stats.memoryBlocks,
+                 stats.maxMemoryAllocations, stats.allocations, stats.allocationBytes / (1024.0 * 1024.0), stats.blockBytes / (1024.0 * 1024.0));
+    fmt::println("texture pool: {} allocations in {} blocks", stats.texturePoolAllocations, stats.texturePoolBlocks);
+    fmt::println("images created: {} pooled, {} dedicated, {} lazily allocated, {} default", stats.pooledImages, stats.dedicatedImages,
+                 stats.lazyImages, stats.defaultImages);
+    const auto& defragmentation = defragmenter.getStats();
+    fmt::println("defragmentation: {} allocations moved ({:.1f} MB) in {} passes, {} blocks freed ({:.1f} MB)", defragmentation.allocationsMoved,
+                 defragmentation.bytesMoved / (1024.0 * 1024.0), defragmentation.passes, defragmentation.blocksFreed,
+                 defragmentation.bytesFreed / (1024.0 * 1024.0));
 }
 
 void Hellion::HDevice::createCommandPool()
@@ -286,9 +538,14 @@ void Hellion::HDevice::createCommandPool()
     poolInfo.flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer;
     poolInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
 
+    vk::CommandPoolCreateInfo computePoolInfo = {};
+    computePoolInfo.flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer;
+    computePoolInfo.queueFamilyIndex = computeFamilyIndex;
+
     try
     {
         commandPool = device.createCommandPool(poolInfo);
+        computeCommandPool = device.createCommandPool(computePoolInfo);
     }
     catch (vk::SystemError err)
     {
@@ -296,14 +553,35 @@ void Hellion::HDevice::createCommandPool()
     }
 }
 
+vk::Semaphore Hellion::HDevice::createTimelineSemaphore(uint64_t initialValue)
+{
+    vk::SemaphoreTypeCreateInfo typeInfo{};
+    typeInfo.semaphoreType = vk::SemaphoreType::eTimeline;
+    typeInfo.initialValue = initialValue;
+
+    vk::SemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.pNext = &typeInfo;
+
+    return device.createSemaphore(semaphoreInfo);
+}
+
 std::pair<VmaAllocation, VmaAllocationInfo>
-Hellion::HDevice::createBufferVma(vk::DeviceSize size, vk::BufferUsageFlags usage, vk::Buffer& buffer, VmaAllocationCreateFlags flags)
+Hellion::HDevice::createBufferVma(vk::DeviceSize size, vk::BufferUsageFlags usage, vk::Buffer& buffer, VmaAllocationCreateFlags flags,
+                                  bool shareWithCompute)
 {
     HELLION_ZONE_PROFILING()
     vk::BufferCreateInfo bufferInfo = {};
     bufferInfo.size = size;
     bufferInfo.usage = usage;
     bufferInfo.sharingMode = vk::SharingMode::eExclusive;
+    // buffers written on the compute family and read on the graphics family skip queue family ownership transfers
+    uint32_t families[] = {graphicsFamilyIndex, computeFamilyIndex};
+    if(shareWithCompute && graphicsFamilyIndex != computeFamilyIndex)
+    {
+        bufferInfo.sharingMode = vk::SharingMode::eConcurrent;
+        bufferInfo.queueFamilyIndexCount = 2;
+        bufferInfo.pQueueFamilyIndices = families;
+    }
 
     VmaAllocationCreateInfo vbAllocCreateInfo = {};
     vbAllocCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
@@ -313,6 +591,8 @@ Hellion::HDevice::createBufferVma(vk::DeviceSize size, vk::BufferUsageFlags usag
     VmaAllocationInfo stagingVertexBufferAllocInfo = {};
     vmaCreateBuffer(g_hAllocator, (VkBufferCreateInfo*) &bufferInfo, &vbAllocCreateInfo, (VkBuffer*) &buffer, &stagingVertexBufferAlloc,
                     &stagingVertexBufferAllocInfo);
+    if(stagingVertexBufferAlloc)
+        trackAllocation(stagingVertexBufferAlloc, allocationCategory(usage, flags));
     return {stagingVertexBufferAlloc, stagingVertexBufferAllocInfo};
 }
 
@@ -371,15 +651,7 @@ Hellion::HDevice::createImage(uint32_t width, uint32_t height, uint32_t mipLevel
     imageInfo.sharingMode = vk::SharingMode::eExclusive;
     imageInfo.flags = flags;
 
-    VmaAllocationCreateInfo allocCreateInfo = {};
-    allocCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
-    allocCreateInfo.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
-    allocCreateInfo.priority = 1.0f;
-
-    vk::Image img;
-    VmaAllocation alloc;
-    vmaCreateImage(g_hAllocator, reinterpret_cast<VkImageCreateInfo*>(&imageInfo), &allocCreateInfo, reinterpret_cast<VkImage*>(&img), &alloc, nullptr);
-    return {img, alloc};
+    return createImageWithInfo(imageInfo);
 }
 
 void Hellion::HDevice::transitionImageLayout(vk::Image image, vk::Format format, vk::ImageLayout oldLayout, vk::ImageLayout newLayout, uint32_t mipLevels,
@@ -387,6 +659,13 @@ void Hellion::HDevice::transitionImageLayout(vk::Image image, vk::Format format,
 {
     HELLION_ZONE_PROFILING()
     vk::CommandBuffer commandBuffer = beginSingleTimeCommands();
+    transitionImageLayout(commandBuffer, image, format, oldLayout, newLayout, mipLevels, layerCount);
+    endSingleTimeCommands(commandBuffer);
+}
+
+void Hellion::HDevice::transitionImageLayout(vk::CommandBuffer commandBuffer, vk::Image image, vk::Format format, vk::ImageLayout oldLayout,
+                                             vk::ImageLayout newLayout, uint32_t mipLevels, uint32_t layerCount)
+{
     vk::ImageMemoryBarrier barrier{};
     barrier.oldLayout = oldLayout;
     barrier.newLayout = newLayout;
@@ -433,7 +712,6 @@ void Hellion::HDevice::transitionImageLayout(vk::Image image, vk::Format format,
     }
 
     commandBuffer.pipelineBarrier(sourceStage, destinationStage, vk::DependencyFlags(), nullptr, nullptr, barrier);
-    endSingleTimeCommands(commandBuffer);
 }
 
 void Hellion::HDevice::copyBufferToImage(vk::Buffer buffer, vk::Image image, uint32_t width, uint32_t height)
@@ -458,6 +736,106 @@ void Hellion::HDevice::copyBufferToImage(vk::Buffer buffer, vk::Image image, uin
     endSingleTimeCommands(commandBuffer);
 }
 
+void Hellion::HDevice::copyBufferToImage(vk::Buffer buffer, vk::Image image, std::span<const vk::BufferImageCopy> regions)
+{
+    HELLION_ZONE_PROFILING()
+    vk::CommandBuffer commandBuffer = beginSingleTimeCommands();
+    commandBuffer.copyBufferToImage(buffer, image, vk::ImageLayout::eTransferDstOptimal, static_cast<uint32_t>(regions.size()), regions.data());
+    endSingleTimeCommands(commandBuffer);
+}
+
+VmaBudget Hellion::HDevice::getDeviceLocalBudget()
+{
+    VmaBudget budgets[VK_MAX_MEMORY_HEAPS];
+    vmaGetHeapBudgets(g_hAllocator, budgets);
+
+    VmaBudget total{};
+    for(uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++)
+    {
+        if(!(memoryProperties.memoryHeaps[i].flags & vk::MemoryHeapFlagBits::eDeviceLocal))
+            continue;
+        total.statistics.blockCount += budgets[i].statistics.blockCount;
+        total.statistics.allocationCount += budgets[i].statistics.allocationCount;
+        total.statistics.blockBytes += budgets[i].statistics.blockBytes;
+        total.statistics.allocationBytes += budgets[i].statistics.allocationBytes;
+        total.usage += budgets[i].usage;
+        total.budget += budgets[i].budget;
+    }
+    return total;
+}
+
+bool Hellion::HDevice::supportsSampledFormat(vk::Format format)
+{
+    auto features = physicalDevice.getFormatProperties(format).optimalTilingFeatures;
+    auto required = vk::FormatFeatureFlagBits::eSampledImage | vk::FormatFeatureFlagBits::eSampledImageFilterLinear;
+    return (features & required) == required;
+}
+
+bool Hellion::HDevice::supportsLinearBlit(vk::Format format)
+{
+    auto features = physicalDevice.getFormatProperties(format).optimalTilingFeatures;
+    auto required = vk::FormatFeatureFlagBits::eSampledImageFilterLinear | vk::FormatFeatureFlagBits::eBlitSrc | vk::FormatFeatureFlagBits::eBlitDst;
+    return (features & required) == required;
+}
+
+void Hellion::HDevice::generateMipmaps(vk::Image image, vk::Format format, int32_t width, int32_t height, uint32_t mipLevels)
+{
+    HELLION_ZONE_PROFILING()
+    if(!supportsLinearBlit(format))
+        throw std::runtime_error("texture image format does not support linear blitting!");
+
+    vk::CommandBuffer commandBuffer = beginSingleTimeCommands();
+
+    vk::ImageMemoryBarrier barrier{};
+    barrier.image = image;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+    barrier.subresourceRange.levelCount = 1;
+
+    int32_t mipWidth = width;
+    int32_t mipHeight = height;
+    for(uint32_t i = 1; i < mipLevels; i++)
+    {
+        // level i - 1 is complete, it becomes the blit source
+        barrier.subresourceRange.baseMipLevel = i - 1;
+        barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+        barrier.newLayout = vk::ImageLayout::eTransferSrcOptimal;
+        barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+        barrier.dstAccessMask = vk::AccessFlagBits::eTransferRead;
+        commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer, {}, nullptr, nullptr, barrier);
+
+        int32_t nextWidth = mipWidth > 1 ? mipWidth / 2 : 1;
+        int32_t nextHeight = mipHeight > 1 ? mipHeight / 2 : 1;
+        vk::ImageBlit blit{};
+        blit.srcOffsets[1] = vk::Offset3D{mipWidth, mipHeight, 1};
+        blit.srcSubresource = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, i - 1, 0, 1};
+        blit.dstOffsets[1] = vk::Offset3D{nextWidth, nextHeight, 1};
+        blit.dstSubresource = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, i, 0, 1};
+        commandBuffer.blitImage(image, vk::ImageLayout::eTransferSrcOptimal, image, vk::ImageLayout::eTransferDstOptimal, blit, vk::Filter::eLinear);
+
+        barrier.oldLayout = vk::ImageLayout::eTransferSrcOptimal;
+        barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+        barrier.srcAccessMask = vk::AccessFlagBits::eTransferRead;
+        barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+        commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader, {}, nullptr, nullptr, barrier);
+
+        mipWidth = nextWidth;
+        mipHeight = nextHeight;
+    }
+
+    barrier.subresourceRange.baseMipLevel = mipLevels - 1;
+    barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+    barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+    barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+    barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader, {}, nullptr, nullptr, barrier);
+
+    endSingleTimeCommands(commandBuffer);
+}
+
 vk::ImageView
 Hellion::HDevice::createImageView(vk::Image& image, vk::Format format, vk::ImageAspectFlags aspectFlags, uint32_t mipLevels, vk::ImageViewType viewType)
 {
@@ -494,6 +872,15 @@ vk::Format Hellion::HDevice::findSupportedFormat(const std::vector<vk::Format>&
 }
 
 void Hellion::HDevice::copyBuffer(vk::Buffer srcBuffer, vk::Buffer dstBuffer, vk::DeviceSize size)
+{
+    vk::BufferCopy copyRegion = {};
+    copyRegion.srcOffset = 0;
+    copyRegion.dstOffset = 0;
+    copyRegion.size = size;
+    copyBuffer(srcBuffer, dstBuffer, std::span(&copyRegion, 1));
+}
+
+void Hellion::HDevice::copyBuffer(vk::Buffer srcBuffer, vk::Buffer dstBuffer, std::span<const vk::BufferCopy> regions)
 {
     HELLION_ZONE_PROFILING()
     vk::CommandBufferAllocateInfo allocInfo = {};
@@ -508,11 +895,7 @@ void Hellion::HDevice::copyBuffer(vk::Buffer srcBuffer, vk::Buffer dstBuffer, vk
 
     commandBuffer.begin(beginInfo);
 
-    vk::BufferCopy copyRegion = {};
-    copyRegion.srcOffset = 0;
-    copyRegion.dstOffset = 0;
-    copyRegion.size = size;
-    commandBuffer.copyBuffer(srcBuffer, dstBuffer, copyRegion);
+    commandBuffer.copyBuffer(srcBuffer, dstBuffer, static_cast<uint32_t>(regions.size()), regions.data());
 
     commandBuffer.end();
 
@@ -528,7 +911,12 @@ void Hellion::HDevice::copyBuffer(vk::Buffer srcBuffer, vk::Buffer dstBuffer, vk
 
 void Hellion::HDevice::cleanup()
 {
+    defragmenter.destroy();
+    samplerCache.destroy(device);
+    if(texturePool)
+        vmaDestroyPool(g_hAllocator, texturePool);
     device.destroyCommandPool(commandPool);
+    device.destroyCommandPool(computeCommandPool);
     vmaDestroyAllocator(g_hAllocator);
     device.destroy();
     if(enableValidationLayers)
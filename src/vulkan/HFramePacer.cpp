@@ -0,0 +1,95 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/vulkan/HFramePacer.h"
+#include <thread>
+
+void Hellion::HFramePacer::limit()
+{
+    HELLION_ZONE_PROFILING()
+    if(targetFps <= 0.0)
+    {
+        nextFrame = Clock::now();
+        return;
+    }
+
+    auto frameTime = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFps));
+    // sleep is only accurate to about a millisecond, the rest is spun
+    auto spinThreshold = std::chrono::milliseconds(1);
+
+    auto now = Clock::now();
+    if(nextFrame - now > spinThreshold)
+        std::this_thread::sleep_for(nextFrame - now - spinThreshold);
+    while(Clock::now() < nextFrame)
+        std::this_thread::yield();
+
+    // do not try to catch up after a long frame
+    nextFrame = std::max(nextFrame + frameTime, Clock::now());
+}
+
+void Hellion::HFramePacer::waitForPresents(HSwapChain& swapChain)
+{
+    HELLION_ZONE_PROFILING()
+    if(!presentWait)
+        return;
+
+    uint64_t lastId = swapChain.getLastPresentId();
+    // right after recreation the target was presented on the old swapchain, waiting on the new one would run into the timeout
+    if(lastId > presentWaitLag && lastId - presentWaitLag >= swapChain.getFirstPresentId())
+        swapChain.waitForPresent(lastId - presentWaitLag, std::chrono::nanoseconds(std::chrono::milliseconds(100)).count());
+}
+
+void Hellion::HFramePacer::onFrameSubmitted(uint64_t presentId, HPresentPolicy policy)
+{
+    pending.push_back({presentId, inputTime, policy});
+}
+
+void Hellion::HFramePacer::onFrameRetired()
+{
+    if(pending.size() < HSwapChain::MAX_FRAMES_IN_FLIGHT)
+        return;
+    record(pending.front(), Clock::now());
+    pending.pop_front();
+}
+
+void Hellion::HFramePacer::collect(HSwapChain& swapChain)
+{
+    // samples of an older swapchain can't be matched against this one
+    while(!pending.empty() && pending.front().presentId < swapChain.getFirstPresentId())
+        pending.pop_front();
+    while(!pending.empty() && swapChain.waitForPresent(pending.front().presentId, 0))
+    {
+        record(pending.front(), Clock::now());
+        pending.pop_front();
+    }
+}
+
+void Hellion::HFramePacer::report() const
+{
+    fmt::println("input-to-present latency:");
+    for(size_t i = 0; i < POLICY_COUNT; i++)
+    {
+        const auto& s = stats[i];
+        if(s.samples == 0)
+            continue;
+        fmt::println("  {:<12} frames {:>8}  avg {:>7.2f} ms  min {:>7.2f} ms  max {:>7.2f} ms", toString(static_cast<HPresentPolicy>(i)), s.samples,
+                     s.averageMs(), s.minMs, s.maxMs);
+    }
+}
+
+const char* Hellion::toString(HPresentPolicy policy)
+{
+    switch(policy)
+    {
+        case HPresentPolicy::Fifo:
+            return "FIFO";
+        case HPresentPolicy::FifoRelaxed:
+            return "FIFO relaxed";
+        case HPresentPolicy::Mailbox:
+            return "Mailbox";
+        case HPresentPolicy::Immediate:
+            return "Immediate";
+    }
+    return "Unknown";
+}
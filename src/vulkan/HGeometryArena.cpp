@@ -0,0 +1,242 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/vulkan/HGeometryArena.h"
+#include "../../include/core/Profiling.h"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+Hellion::HGeometryArena::HGeometryArena(HDevice& device, vk::DeviceSize vertexCapacity, uint32_t indexCapacity) : device{device},
+                                                                                                                  vertexCapacity{vertexCapacity},
+                                                                                                                  indexCapacity{indexCapacity},
+                                                                                                                  vertexAllocator{vertexCapacity},
+                                                                                                                  indexAllocator{indexCapacity}
+{
+    vertexBuffer = createVertexBuffer();
+    indexBuffer = createIndexBuffer();
+}
+
+Hellion::HGeometryArena::~HGeometryArena()
+{
+    for(auto& buffers: retired)
+    {
+        (void) device.getDevice().waitForFences(buffers.fence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+        destroyRetired(buffers);
+    }
+}
+
+std::unique_ptr<Hellion::HBuffer> Hellion::HGeometryArena::createVertexBuffer() const
+{
+    auto buffer = std::make_unique<HBuffer>(device, vertexCapacity, vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst |
+                                                                    vk::BufferUsageFlagBits::eVertexBuffer, 0);
+    // bind fetches the buffer every frame and uploads go through the graphics queue, so it can be moved
+    buffer->enableDefragmentation();
+    return buffer;
+}
+
+std::unique_ptr<Hellion::HBuffer> Hellion::HGeometryArena::createIndexBuffer() const
+{
+    auto buffer = std::make_unique<HBuffer>(device, indexCapacity * sizeof(uint32_t), vk::BufferUsageFlagBits::eTransferSrc |
+                                                                                      vk::BufferUsageFlagBits::eTransferDst |
+                                                                                      vk::BufferUsageFlagBits::eIndexBuffer, 0);
+    buffer->enableDefragmentation();
+    return buffer;
+}
+
+bool Hellion::HGeometryArena::allocate(Slot& slot, vk::DeviceSize vertexBytes, uint32_t vertexStride, uint32_t indexCount)
+{
+    auto vertexOffset = vertexAllocator.allocate(vertexBytes, vertexStride);
+    if(!vertexOffset)
+        return false;
+    auto firstIndex = indexAllocator.allocate(indexCount);
+    if(!firstIndex)
+    {
+        vertexAllocator.free(*vertexOffset, vertexBytes);
+        return false;
+    }
+    slot.range.vertexOffset = static_cast<int32_t>(*vertexOffset / vertexStride);
+    slot.range.vertexCount = static_cast<uint32_t>(vertexBytes / vertexStride);
+    slot.range.vertexStride = vertexStride;
+    slot.range.firstIndex = static_cast<uint32_t>(*firstIndex);
+    slot.range.indexCount = indexCount;
+    return true;
+}
+
+Hellion::HGeometryHandle Hellion::HGeometryArena::upload(std::span<const std::byte> vertexBytes, uint32_t vertexStride, std::span<const uint32_t> indices)
+{
+    HELLION_ZONE_PROFILING()
+    HGeometryHandle handle;
+    if(!freeSlots.empty())
+    {
+        handle.index = freeSlots.back();
+        freeSlots.pop_back();
+    } else
+    {
+        handle.index = static_cast<uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+    auto& slot = slots[handle.index];
+    handle.generation = slot.generation;
+
+    auto indexCount = static_cast<uint32_t>(indices.size());
+    bool allocated = allocate(slot, vertexBytes.size(), vertexStride, indexCount);
+    // enough space in total means the free space is fragmented, compacting once makes it contiguous
+    if(!allocated && vertexAllocator.getFreeSpace() >= vertexBytes.size() + vertexStride && indexAllocator.getFreeSpace() >= indexCount)
+    {
+        if(defragment())
+            allocated = allocate(slot, vertexBytes.size(), vertexStride, indexCount);
+    }
+    if(!allocated)
+    {
+        freeSlots.push_back(handle.index);
+        throw std::runtime_error("failed to allocate geometry arena range!");
+    }
+    slot.live = true;
+
+    // one staging buffer for both ranges, the indices follow the vertices
+    vk::DeviceSize indexBytes = indices.size_bytes();
+    auto stagingBuffer = HBuffer(device, vertexBytes.size() + indexBytes, vk::BufferUsageFlagBits::eTransferSrc,
+                                 VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT);
+    auto staging = static_cast<std::byte*>(stagingBuffer.getMappedMemory());
+    memcpy(staging, vertexBytes.data(), vertexBytes.size());
+    memcpy(staging + vertexBytes.size(), indices.data(), indexBytes);
+
+    vk::BufferCopy vertexCopy{0, static_cast<vk::DeviceSize>(slot.range.vertexOffset) * vertexStride, vertexBytes.size()};
+    vk::BufferCopy indexCopy{vertexBytes.size(), slot.range.firstIndex * sizeof(uint32_t), indexBytes};
+    device.copyBuffer(stagingBuffer.getBuffer(), vertexBuffer->getBuffer(), std::span(&vertexCopy, 1));
+    device.copyBuffer(stagingBuffer.getBuffer(), indexBuffer->getBuffer(), std::span(&indexCopy, 1));
+    return handle;
+}
+
+void Hellion::HGeometryArena::release(HGeometryHandle handle)
+{
+    auto& slot = slots.at(handle.index);
+    assert(slot.live && slot.generation == handle.generation && "geometry handle was already released");
+    vertexAllocator.free(static_cast<uint64_t>(slot.range.vertexOffset) * slot.range.vertexStride,
+                         static_cast<uint64_t>(slot.range.vertexCount) * slot.range.vertexStride);
+    indexAllocator.free(slot.range.firstIndex, slot.range.indexCount);
+    slot.live = false;
+    slot.generation++;
+    freeSlots.push_back(handle.index);
+}
+
+const Hellion::HGeometryRange& Hellion::HGeometryArena::getRange(HGeometryHandle handle) const
+{
+    auto& slot = slots.at(handle.index);
+    assert(slot.live && slot.generation == handle.generation && "stale geometry handle");
+    return slot.range;
+}
+
+void Hellion::HGeometryArena::bind(vk::CommandBuffer buffer) const
+{
+    vk::Buffer vertexBuffers[] = {vertexBuffer->getBuffer()};
+    vk::DeviceSize offsets[] = {0};
+    buffer.bindVertexBuffers(0, 1, vertexBuffers, offsets);
+    buffer.bindIndexBuffer(indexBuffer->getBuffer(), 0, vk::IndexType::eUint32);
+}
+
+bool Hellion::HGeometryArena::defragment()
+{
+    HELLION_ZONE_PROFILING()
+    size_t vertexBlocks = vertexAllocator.getFreeBlockCount();
+    size_t indexBlocks = indexAllocator.getFreeBlockCount();
+
+    // live ranges are packed in their current order, which keeps the copies sequential
+    std::vector<uint32_t> order;
+    for(uint32_t i = 0; i < slots.size(); i++)
+        if(slots[i].live)
+            order.push_back(i);
+    std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+    {
+        const auto& ra = slots[a].range;
+        const auto& rb = slots[b].range;
+        return static_cast<uint64_t>(ra.vertexOffset) * ra.vertexStride < static_cast<uint64_t>(rb.vertexOffset) * rb.vertexStride;
+    });
+
+    // the packed layout is built on fresh allocators, so a range that does not fit leaves the arena as it was
+    HRangeAllocator packedVertices{vertexCapacity};
+    HRangeAllocator packedIndices{indexCapacity};
+    std::vector<HGeometryRange> packed;
+    packed.reserve(order.size());
+    std::vector<vk::BufferCopy> vertexCopies;
+    std::vector<vk::BufferCopy> indexCopies;
+    for(uint32_t index: order)
+    {
+        const auto& range = slots[index].range;
+        vk::DeviceSize vertexBytes = static_cast<vk::DeviceSize>(range.vertexCount) * range.vertexStride;
+        auto vertexOffset = packedVertices.allocate(vertexBytes, range.vertexStride);
+        auto firstIndex = packedIndices.allocate(range.indexCount);
+        if(!vertexOffset || !firstIndex)
+            return false;
+
+        HGeometryRange moved = range;
+        moved.vertexOffset = static_cast<int32_t>(*vertexOffset / range.vertexStride);
+        moved.firstIndex = static_cast<uint32_t>(*firstIndex);
+        packed.push_back(moved);
+        if(vertexBytes > 0)
+            vertexCopies.push_back({static_cast<vk::DeviceSize>(range.vertexOffset) * range.vertexStride, *vertexOffset, vertexBytes});
+        if(range.indexCount > 0)
+            indexCopies.push_back({range.firstIndex * sizeof(uint32_t), *firstIndex * sizeof(uint32_t), range.indexCount * sizeof(uint32_t)});
+    }
+
+    // ranges can overlap their old location, so everything is copied into new buffers instead of moving in place
+    auto newVertexBuffer = createVertexBuffer();
+    auto newIndexBuffer = createIndexBuffer();
+
+    vk::CommandBufferAllocateInfo allocInfo{};
+    allocInfo.level = vk::CommandBufferLevel::ePrimary;
+    allocInfo.commandPool = device.getCommandPool();
+    allocInfo.commandBufferCount = 1;
+    vk::CommandBuffer commandBuffer = device.getDevice().allocateCommandBuffers(allocInfo)[0];
+    commandBuffer.begin(vk::CommandBufferBeginInfo{vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+    if(!vertexCopies.empty())
+        commandBuffer.copyBuffer(vertexBuffer->getBuffer(), newVertexBuffer->getBuffer(), vertexCopies);
+    if(!indexCopies.empty())
+        commandBuffer.copyBuffer(indexBuffer->getBuffer(), newIndexBuffer->getBuffer(), indexCopies);
+    // frames and uploads recorded from now on use the new buffers and are submitted after the copy on the same queue
+    vk::MemoryBarrier barrier{vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eVertexAttributeRead | vk::AccessFlagBits::eIndexRead |
+                                                                  vk::AccessFlagBits::eTransferRead | vk::AccessFlagBits::eTransferWrite};
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eVertexInput | vk::PipelineStageFlagBits::eTransfer,
+                                  {}, barrier, {}, {});
+    commandBuffer.end();
+
+    // the fence also covers the frames submitted before the copy, which are the last readers of the old buffers
+    vk::Fence fence = device.getDevice().createFence(vk::FenceCreateInfo{});
+    vk::SubmitInfo submitInfo{};
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+    device.getGraphicsQueue().submit(submitInfo, fence);
+
+    retired.push_back({std::move(vertexBuffer), std::move(indexBuffer), commandBuffer, fence});
+    vertexBuffer = std::move(newVertexBuffer);
+    indexBuffer = std::move(newIndexBuffer);
+    vertexAllocator = std::move(packedVertices);
+    indexAllocator = std::move(packedIndices);
+    for(size_t i = 0; i < order.size(); i++)
+        slots[order[i]].range = packed[i];
+
+    fmt::println("geometry arena defragmented, free blocks {} -> {} (vertices), {} -> {} (indices)", vertexBlocks,
+                 vertexAllocator.getFreeBlockCount(), indexBlocks, indexAllocator.getFreeBlockCount());
+    return true;
+}
+
+void Hellion::HGeometryArena::update()
+{
+    std::erase_if(retired, [this](RetiredBuffers& buffers)
+    {
+        if(device.getDevice().getFenceStatus(buffers.fence) != vk::Result::eSuccess)
+            return false;
+        destroyRetired(buffers);
+        return true;
+    });
+}
+
+void Hellion::HGeometryArena::destroyRetired(RetiredBuffers& buffers)
+{
+    device.getDevice().freeCommandBuffers(device.getCommandPool(), buffers.commandBuffer);
+    device.getDevice().destroy(buffers.fence);
+    buffers.vertexBuffer.reset();
+    buffers.indexBuffer.reset();
+}
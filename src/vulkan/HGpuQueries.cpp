@@ -0,0 +1,185 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/vulkan/HGpuQueries.h"
+#include "../../include/vulkan/HDevice.h"
+#include "../../include/core/HProfiler.h"
+#include <algorithm>
+#include <cassert>
+#include <fmt/core.h>
+
+namespace
+{
+    constexpr double NS_PER_MS = 1000000.0;
+}
+
+void Hellion::HGpuQueries::init(HDevice& device)
+{
+    this->device = &device;
+    auto families = device.getPhysicalDevice().getQueueFamilyProperties();
+    uint32_t validBits = families[device.getGraphicsFamily()].timestampValidBits;
+    if(validBits == 0)
+    {
+        fmt::println("graphics queue has no timestamps, GPU pass times are not recorded");
+        return;
+    }
+    timestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+    timestampPeriod = device.getProperties().limits.timestampPeriod;
+
+    vk::QueryPoolCreateInfo poolInfo{};
+    poolInfo.queryType = vk::QueryType::eTimestamp;
+    poolInfo.queryCount = HSwapChain::MAX_FRAMES_IN_FLIGHT * TIMESTAMPS_PER_SLOT;
+    timestampPool = device.getDevice().createQueryPool(poolInfo);
+
+    if(device.supportsPipelineStatistics())
+    {
+        vk::QueryPoolCreateInfo statisticsInfo{};
+        statisticsInfo.queryType = vk::QueryType::ePipelineStatistics;
+        statisticsInfo.queryCount = HSwapChain::MAX_FRAMES_IN_FLIGHT * MAX_PASSES;
+        statisticsInfo.pipelineStatistics = vk::QueryPipelineStatisticFlagBits::eVertexShaderInvocations |
+                                            vk::QueryPipelineStatisticFlagBits::eClippingPrimitives |
+                                            vk::QueryPipelineStatisticFlagBits::eFragmentShaderInvocations;
+        statisticsPool = device.getDevice().createQueryPool(statisticsInfo);
+    }
+}
+
+void Hellion::HGpuQueries::destroy()
+{
+    if(!device)
+        return;
+    device->getDevice().destroy(timestampPool);
+    device->getDevice().destroy(statisticsPool);
+    timestampPool = nullptr;
+    statisticsPool = nullptr;
+}
+
+void Hellion::HGpuQueries::beginFrame(vk::CommandBuffer commandBuffer, uint32_t slotIndex, uint64_t frame)
+{
+    if(!timestampPool)
+        return;
+    currentSlot = slotIndex;
+    auto& slot = slots[slotIndex];
+    if(slot.written)
+        readResults(slot);
+
+    slot = Slot{frame};
+    slot.statistics = pipelineStatistics;
+    commandBuffer.resetQueryPool(timestampPool, slotIndex * TIMESTAMPS_PER_SLOT, TIMESTAMPS_PER_SLOT);
+    if(slot.statistics)
+        commandBuffer.resetQueryPool(statisticsPool, slotIndex * MAX_PASSES, MAX_PASSES);
+    commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, timestampPool, slotIndex * TIMESTAMPS_PER_SLOT);
+}
+
+void Hellion::HGpuQueries::endFrame(vk::CommandBuffer commandBuffer)
+{
+    if(!timestampPool)
+        return;
+    assert(!passActive && "Can't end the frame while a GPU pass is in progress");
+    commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, timestampPool, currentSlot * TIMESTAMPS_PER_SLOT + 1);
+    slots[currentSlot].written = true;
+}
+
+void Hellion::HGpuQueries::beginPass(vk::CommandBuffer commandBuffer, const char* name)
+{
+    assert(!passActive && "GPU passes can't nest");
+    auto& slot = slots[currentSlot];
+    if(!timestampPool || slot.passCount == MAX_PASSES)
+        return;
+    passActive = true;
+
+    auto it = std::find_if(passes.begin(), passes.end(), [name](const HGpuPassStats& pass)
+    { return pass.name == name; });
+    if(it == passes.end())
+        it = passes.insert(passes.end(), HGpuPassStats{name});
+    slot.passIndices[slot.passCount] = static_cast<uint32_t>(it - passes.begin());
+
+    uint32_t query = currentSlot * TIMESTAMPS_PER_SLOT + 2 + slot.passCount * 2;
+    commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, timestampPool, query);
+    if(slot.statistics)
+        commandBuffer.beginQuery(statisticsPool, currentSlot * MAX_PASSES + slot.passCount, {});
+}
+
+void Hellion::HGpuQueries::endPass(vk::CommandBuffer commandBuffer)
+{
+    if(!passActive)
+        return;
+    passActive = false;
+    auto& slot = slots[currentSlot];
+    if(slot.statistics)
+        commandBuffer.endQuery(statisticsPool, currentSlot * MAX_PASSES + slot.passCount);
+    uint32_t query = currentSlot * TIMESTAMPS_PER_SLOT + 3 + slot.passCount * 2;
+    commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, timestampPool, query);
+    slot.passCount++;
+}
+
+void Hellion::HGpuQueries::readResults(Slot& slot)
+{
+    slot.written = false;
+    uint32_t slotIndex = static_cast<uint32_t>(&slot - slots.data());
+    uint32_t count = 2 + slot.passCount * 2;
+    std::array<uint64_t, TIMESTAMPS_PER_SLOT> timestamps{};
+    // the slot's fence was waited on, without eWait an unfinished query reports eNotReady instead of blocking
+    auto result = device->getDevice().getQueryPoolResults(timestampPool, slotIndex * TIMESTAMPS_PER_SLOT, count, count * sizeof(uint64_t),
+                                                          timestamps.data(), sizeof(uint64_t), vk::QueryResultFlagBits::e64);
+    if(result != vk::Result::eSuccess)
+        return;
+
+    auto toMs = [this](uint64_t begin, uint64_t end)
+    {
+        uint64_t ticks = ((end & timestampMask) - (begin & timestampMask)) & timestampMask;
+        return static_cast<double>(ticks) * timestampPeriod / NS_PER_MS;
+    };
+
+    frameMs = toMs(timestamps[0], timestamps[1]);
+    resultFrame = slot.frame;
+    HProfiler::global().recordGpuFrame(slot.frame, frameMs);
+
+    std::array<uint64_t, MAX_PASSES * STATISTICS_COUNT> statistics{};
+    bool hasStatistics = slot.statistics && slot.passCount > 0 &&
+                         device->getDevice().getQueryPoolResults(statisticsPool, slotIndex * MAX_PASSES, slot.passCount,
+                                                                 slot.passCount * STATISTICS_COUNT * sizeof(uint64_t), statistics.data(),
+                                                                 STATISTICS_COUNT * sizeof(uint64_t), vk::QueryResultFlagBits::e64) ==
+                         vk::Result::eSuccess;
+
+    for(auto& pass: passes)
+    {
+        pass.lastMs = 0.0;
+        pass.vertexInvocations = 0;
+        pass.clippingPrimitives = 0;
+        pass.fragmentInvocations = 0;
+    }
+    for(uint32_t i = 0; i < slot.passCount; i++)
+    {
+        auto& pass = passes[slot.passIndices[i]];
+        double ms = toMs(timestamps[2 + i * 2], timestamps[3 + i * 2]);
+        // a pass recorded twice in a frame is summed
+        pass.lastMs += ms;
+        pass.totalMs += ms;
+        pass.maxMs = std::max(pass.maxMs, pass.lastMs);
+        if(std::find(slot.passIndices.begin(), slot.passIndices.begin() + i, slot.passIndices[i]) == slot.passIndices.begin() + i)
+            pass.frames++;
+        if(hasStatistics)
+        {
+            pass.vertexInvocations += statistics[i * STATISTICS_COUNT];
+            pass.clippingPrimitives += statistics[i * STATISTICS_COUNT + 1];
+            pass.fragmentInvocations += statistics[i * STATISTICS_COUNT + 2];
+        }
+    }
+}
+
+const Hellion::HGpuPassStats* Hellion::HGpuQueries::findPass(std::string_view name) const
+{
+    auto it = std::find_if(passes.begin(), passes.end(), [name](const HGpuPassStats& pass)
+    { return name == pass.name; });
+    return it == passes.end() ? nullptr : &*it;
+}
+
+void Hellion::HGpuQueries::report() const
+{
+    if(passes.empty())
+        return;
+    fmt::println("GPU passes:");
+    for(const auto& pass: passes)
+        fmt::println("  {:<24} frames {:>8}  avg {:>7.3f} ms  max {:>7.3f} ms", pass.name, pass.frames, pass.averageMs(), pass.maxMs);
+}
@@ -0,0 +1,143 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/vulkan/HMemoryMonitor.h"
+#include <fstream>
+#include <imgui.h>
+#include <nlohmann/json.hpp>
+
+namespace
+{
+    constexpr double MEGABYTE = 1024.0 * 1024.0;
+
+    std::string buildStatsString(VmaAllocator allocator)
+    {
+        char* stats = nullptr;
+        vmaBuildStatsString(allocator, &stats, VK_TRUE);
+        std::string result = stats;
+        vmaFreeStatsString(allocator, stats);
+        return result;
+    }
+}
+
+void Hellion::HMemoryMonitor::update()
+{
+    HELLION_ZONE_PROFILING()
+    HELLION_ALLOCATION_SCOPE("HMemoryMonitor::update")
+    auto allocator = device.getAllocator();
+    // with VK_EXT_memory_budget VMA refreshes the driver numbers when the frame index changes
+    vmaSetCurrentFrameIndex(allocator, static_cast<uint32_t>(++frame));
+
+    const auto& memoryProperties = device.getMemoryProperties();
+    VmaBudget budgets[VK_MAX_MEMORY_HEAPS];
+    vmaGetHeapBudgets(allocator, budgets);
+
+    heaps.resize(memoryProperties.memoryHeapCount);
+    heapWarned.resize(memoryProperties.memoryHeapCount, false);
+    for(uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++)
+    {
+        auto& heap = heaps[i];
+        heap.size = memoryProperties.memoryHeaps[i].size;
+        heap.deviceLocal = static_cast<bool>(memoryProperties.memoryHeaps[i].flags & vk::MemoryHeapFlagBits::eDeviceLocal);
+        heap.budget = budgets[i].budget;
+        heap.usage = budgets[i].usage;
+        heap.blockBytes = budgets[i].statistics.blockBytes;
+        heap.allocationBytes = budgets[i].statistics.allocationBytes;
+        heap.blockCount = budgets[i].statistics.blockCount;
+        heap.allocationCount = budgets[i].statistics.allocationCount;
+
+        auto limit = static_cast<vk::DeviceSize>(static_cast<double>(heap.budget) * WARNING_RATIO);
+        bool pressure = heap.usage > limit;
+        if(pressure && !heapWarned[i])
+            fmt::println("memory heap {} is at {:.1f} of {:.1f} MB budget", i, heap.usage / MEGABYTE, heap.budget / MEGABYTE);
+        heapWarned[i] = pressure;
+        if(pressure && heap.deviceLocal)
+            for(auto& callback: pressureCallbacks)
+                callback(i, heap.usage - limit);
+    }
+
+    if(frame % CATEGORY_REFRESH_FRAMES == 1)
+        refreshCategories();
+}
+
+void Hellion::HMemoryMonitor::refreshCategories()
+{
+    HELLION_ZONE_PROFILING()
+    categories = device.getCategoryUsage();
+}
+
+void Hellion::HMemoryMonitor::dumpJson(const std::string& path)
+{
+    HELLION_ZONE_PROFILING()
+    refreshCategories();
+    auto json = nlohmann::json::parse(buildStatsString(device.getAllocator()));
+    auto& summary = json["Hellion"];
+    summary["MemoryBudgetExtension"] = device.hasMemoryBudget();
+    const auto& defragmentation = device.getDefragmenter().getStats();
+    summary["Defragmentation"] = {{"BytesMoved", defragmentation.bytesMoved}, {"BytesFreed", defragmentation.bytesFreed},
+                                  {"AllocationsMoved", defragmentation.allocationsMoved}, {"BlocksFreed", defragmentation.blocksFreed},
+                                  {"Passes", defragmentation.passes}};
+    for(uint32_t i = 0; i < heaps.size(); i++)
+    {
+        summary["Heaps"].push_back({{"Index", i}, {"DeviceLocal", heaps[i].deviceLocal}, {"Size", heaps[i].size}, {"Budget", heaps[i].budget},
+                                    {"Usage", heaps[i].usage}, {"Blocks", heaps[i].blockCount}, {"Allocations", heaps[i].allocationCount}});
+    }
+    for(const auto& [name, usage]: categories)
+        summary["Categories"][name] = {{"Bytes", usage.bytes}, {"Allocations", usage.allocations}};
+
+    std::ofstream out(path, std::ios::trunc);
+    if(!out.is_open())
+        throw std::runtime_error("failed to write memory statistics!");
+    out << json.dump(2);
+    fmt::println("memory statistics written to {}", path);
+}
+
+void Hellion::HMemoryMonitor::drawUi()
+{
+    ImGui::Begin("Memory");
+    ImGui::Text("Budget source: %s", device.hasMemoryBudget() ? "VK_EXT_memory_budget" : "estimate");
+    for(uint32_t i = 0; i < heaps.size(); i++)
+    {
+        const auto& heap = heaps[i];
+        float fraction = heap.budget > 0 ? static_cast<float>(static_cast<double>(heap.usage) / heap.budget) : 0.0f;
+        auto label = fmt::format("{:.0f} / {:.0f} MB", heap.usage / MEGABYTE, heap.budget / MEGABYTE);
+        ImGui::Text("Heap %u%s", i, heap.deviceLocal ? " (device local)" : "");
+        ImGui::ProgressBar(fraction, ImVec2(-1.0f, 0.0f), label.c_str());
+        ImGui::Text("  %u blocks %.1f MB, %u allocations %.1f MB", heap.blockCount, heap.blockBytes / MEGABYTE, heap.allocationCount,
+                    heap.allocationBytes / MEGABYTE);
+    }
+
+    if(ImGui::BeginTable("Categories", 3))
+    {
+        ImGui::TableSetupColumn("Category");
+        ImGui::TableSetupColumn("MB");
+        ImGui::TableSetupColumn("Allocations");
+        ImGui::TableHeadersRow();
+        for(const auto& [name, usage]: categories)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(name.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", usage.bytes / MEGABYTE);
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", usage.allocations);
+        }
+        ImGui::EndTable();
+    }
+
+    auto& defragmenter = device.getDefragmenter();
+    const auto& defragmentation = defragmenter.getStats();
+    bool defragment = defragmenter.isEnabled();
+    if(ImGui::Checkbox("Defragment", &defragment))
+        defragmenter.setEnabled(defragment);
+    ImGui::SameLine();
+    ImGui::TextUnformatted(defragmentation.running ? "running" : "idle");
+    ImGui::Text("  moved %u allocations %.1f MB in %u passes, freed %u blocks %.1f MB", defragmentation.allocationsMoved,
+                defragmentation.bytesMoved / MEGABYTE, defragmentation.passes, defragmentation.blocksFreed, defragmentation.bytesFreed / MEGABYTE);
+
+    if(ImGui::Button("Dump JSON"))
+        dumpJson("memory_stats.json");
+    ImGui::End();
+}
@@ -0,0 +1,116 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/vulkan/HMeshletCuller.h"
+#include "../../include/core/Profiling.h"
+#include <algorithm>
+
+Hellion::HMeshletCuller::HMeshletCuller(HDevice& device, std::span<const HMeshlet> meshlets) : device{device},
+                                                                                               meshletCount{static_cast<uint32_t>(meshlets.size())}
+{
+    if(device.supportsMultiDrawIndirect())
+        maxDrawCount = device.getProperties().limits.maxDrawIndirectCount;
+    createBuffers(meshlets);
+    createPipeline();
+}
+
+Hellion::HMeshletCuller::~HMeshletCuller()
+{
+    pipeline.reset();
+    device.getDevice().destroy(pipelineLayout);
+}
+
+void Hellion::HMeshletCuller::createBuffers(std::span<const HMeshlet> meshlets)
+{
+    HELLION_ZONE_PROFILING()
+    vk::DeviceSize meshletSize = meshlets.size_bytes();
+    auto stagingBuffer = HBuffer(device, meshletSize, vk::BufferUsageFlagBits::eTransferSrc, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                                                                                            VMA_ALLOCATION_CREATE_MAPPED_BIT);
+    memcpy(stagingBuffer.getMappedMemory(), meshlets.data(), (size_t) meshletSize);
+    meshletBuffer = std::make_unique<HBuffer>(device, meshletSize, vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eStorageBuffer, 0,
+                                              1, true);
+    device.copyBuffer(stagingBuffer.getBuffer(), meshletBuffer->getBuffer(), meshletSize);
+
+    drawBuffers.resize(HSwapChain::MAX_FRAMES_IN_FLIGHT);
+    for(auto& drawBuffer: drawBuffers)
+        drawBuffer = std::make_unique<HBuffer>(device, meshletCount * sizeof(vk::DrawIndexedIndirectCommand),
+                                               vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer, 0, 1, true);
+}
+
+void Hellion::HMeshletCuller::createPipeline()
+{
+    HELLION_ZONE_PROFILING()
+    descriptorPool =
+            HDescriptorPool::Builder(device)
+                    .setMaxSets(HSwapChain::MAX_FRAMES_IN_FLIGHT)
+                    .addPoolSize(vk::DescriptorType::eStorageBuffer, 2 * HSwapChain::MAX_FRAMES_IN_FLIGHT)
+                    .build();
+
+    descriptorSetLayout =
+            HDescriptorSetLayout::Builder(device)
+                    .addBinding(0, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute)
+                    .addBinding(1, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute)
+                    .build();
+
+    descriptorSets.resize(HSwapChain::MAX_FRAMES_IN_FLIGHT);
+    for(size_t i = 0; i < descriptorSets.size(); i++)
+    {
+        auto meshletInfo = meshletBuffer->descriptorInfo();
+        auto drawInfo = drawBuffers[i]->descriptorInfo();
+        HDescriptorWriter(*descriptorSetLayout, *descriptorPool)
+                .writeBuffer(0, &meshletInfo)
+                .writeBuffer(1, &drawInfo)
+                .build(descriptorSets[i]);
+    }
+
+    static_assert(sizeof(CullConstants) <= 128, "push constants beyond 128 bytes are not guaranteed");
+    vk::PushConstantRange pushConstantRange{vk::ShaderStageFlagBits::eCompute, 0, sizeof(CullConstants)};
+    vk::PipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout->getDescriptorSetLayout();
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+    pipelineLayout = device.createPipelineLayout(pipelineLayoutInfo);
+
+    pipeline = std::make_unique<HPipeline>(device, HShader(SHADER_PATH), pipelineLayout);
+}
+
+void Hellion::HMeshletCuller::cull(vk::CommandBuffer computeBuffer, uint32_t currentFrame, const HGeometryRange& range, const glm::mat4& viewProj,
+                                   const glm::mat4& model, glm::vec3 cameraPosition, tracy::VkCtx* tracyCtx)
+{
+    HELLION_ZONE_PROFILING()
+    HELLION_GPUZONE_PROFILING(tracyCtx, computeBuffer, "meshlet culling")
+
+    // planes of the object space clip volume (Gribb, Hartmann), normalized so the sphere radius can be compared directly;
+    // this assumes the model matrix has a uniform scale
+    glm::mat4 clip = glm::transpose(viewProj * model);
+    CullConstants constants{};
+    constants.frustum[0] = clip[3] + clip[0];
+    constants.frustum[1] = clip[3] - clip[0];
+    constants.frustum[2] = clip[3] + clip[1];
+    constants.frustum[3] = clip[3] - clip[1];
+    constants.frustum[4] = clip[3] + clip[2];
+    constants.frustum[5] = clip[3] - clip[2];
+    for(auto& plane: constants.frustum)
+        plane /= glm::length(glm::vec3(plane));
+    constants.cameraPosition = glm::inverse(model) * glm::vec4(cameraPosition, 1.0f);
+    constants.meshletCount = meshletCount;
+    constants.firstIndex = range.firstIndex;
+    constants.vertexOffset = range.vertexOffset;
+
+    pipeline->bind(computeBuffer);
+    computeBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, pipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
+    computeBuffer.pushConstants(pipelineLayout, vk::ShaderStageFlagBits::eCompute, 0, sizeof(CullConstants), &constants);
+    computeBuffer.dispatch((meshletCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+}
+
+void Hellion::HMeshletCuller::draw(vk::CommandBuffer buffer, uint32_t currentFrame)
+{
+    HELLION_ZONE_PROFILING()
+    auto drawBuffer = drawBuffers[currentFrame]->getBuffer();
+    constexpr auto stride = static_cast<uint32_t>(sizeof(vk::DrawIndexedIndirectCommand));
+    // without multiDrawIndirect maxDrawCount stays 1 and every meshlet is its own indirect draw
+    for(uint32_t first = 0; first < meshletCount; first += maxDrawCount)
+        buffer.drawIndexedIndirect(drawBuffer, first * stride, std::min(maxDrawCount, meshletCount - first), stride);
+}
@@ -0,0 +1,207 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/vulkan/HPerfOverlay.h"
+#include "../../include/core/HProfiler.h"
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <fmt/core.h>
+#include <imgui.h>
+
+namespace
+{
+    /// nearest rank on sorted samples
+    double percentile(const std::vector<float>& sorted, double fraction)
+    {
+        auto rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    }
+}
+
+void Hellion::HPerfOverlay::update()
+{
+    auto& profiler = HProfiler::global();
+    const auto& history = profiler.getHistory();
+    uint64_t end = profiler.getFrame();
+    if(end - nextFrame > HProfiler::HISTORY_SIZE)
+        nextFrame = end - HProfiler::HISTORY_SIZE;
+    for(; nextFrame < end; nextFrame++)
+    {
+        double ms = history[nextFrame % HProfiler::HISTORY_SIZE].cpuMs;
+        // the first frame includes loading
+        if(nextFrame == 0)
+            continue;
+        if(runningAverageMs > 0.0 && ms > runningAverageMs * HITCH_FACTOR && ms - runningAverageMs > HITCH_MIN_MS)
+        {
+            hitches++;
+            lastHitchMs = ms;
+            lastHitchFrame = nextFrame;
+            // a hitch would drag the average up and hide the ones right after it
+            continue;
+        }
+        runningAverageMs = runningAverageMs > 0.0 ? runningAverageMs * 0.95 + ms * 0.05 : ms;
+    }
+}
+
+Hellion::HFrameTimeStats Hellion::HPerfOverlay::computeStats(bool gpu)
+{
+    auto& profiler = HProfiler::global();
+    const auto& history = profiler.getHistory();
+    uint64_t end = profiler.getFrame();
+    uint64_t first = end > HProfiler::HISTORY_SIZE ? end - HProfiler::HISTORY_SIZE : 1;
+
+    timeline.clear();
+    for(uint64_t i = first; i < end; i++)
+    {
+        const auto& timing = history[i % HProfiler::HISTORY_SIZE];
+        double ms = gpu ? timing.gpuMs : timing.cpuMs;
+        if(ms >= 0.0)
+            timeline.push_back(static_cast<float>(ms));
+    }
+
+    HFrameTimeStats stats;
+    if(timeline.empty())
+        return stats;
+    sorted.assign(timeline.begin(), timeline.end());
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for(float ms: sorted)
+        total += ms;
+    stats.samples = sorted.size();
+    stats.averageMs = total / static_cast<double>(sorted.size());
+    stats.p50Ms = percentile(sorted, 0.50);
+    stats.p95Ms = percentile(sorted, 0.95);
+    stats.p99Ms = percentile(sorted, 0.99);
+    stats.maxMs = sorted.back();
+    return stats;
+}
+
+void Hellion::HPerfOverlay::drawFrameTimes(const char* label, bool gpu)
+{
+    auto stats = computeStats(gpu);
+    if(stats.samples == 0)
+    {
+        ImGui::Text("%s: no samples", label);
+        return;
+    }
+    ImGui::Text("%s  avg %.2f  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms", label, stats.averageMs, stats.p50Ms, stats.p95Ms, stats.p99Ms,
+                stats.maxMs);
+    ImGui::PushID(label);
+    auto scale = std::max(static_cast<float>(stats.maxMs), 0.001f);
+    ImGui::PlotLines("##timeline", timeline.data(), static_cast<int>(timeline.size()), 0, nullptr, 0.0f, scale, ImVec2(-1.0f, 60.0f));
+
+    std::array<float, HISTOGRAM_BUCKETS> buckets{};
+    for(float ms: sorted)
+        buckets[std::min(static_cast<int>(ms / scale * HISTOGRAM_BUCKETS), HISTOGRAM_BUCKETS - 1)]++;
+    auto overlay = fmt::format("0 - {:.1f} ms", stats.maxMs);
+    ImGui::PlotHistogram("##histogram", buckets.data(), HISTOGRAM_BUCKETS, 0, overlay.c_str(), 0.0f, FLT_MAX, ImVec2(-1.0f, 60.0f));
+    ImGui::PopID();
+}
+
+void Hellion::HPerfOverlay::drawUi()
+{
+    update();
+    ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+    if(!ImGui::Begin("Performance"))
+    {
+        ImGui::End();
+        return;
+    }
+    if(!HProfiler::enabled())
+    {
+        ImGui::TextUnformatted("Built without HELLION_LIGHT_PROFILING");
+        ImGui::End();
+        return;
+    }
+
+    drawFrameTimes("CPU", false);
+    drawFrameTimes("GPU", true);
+    ImGui::Text("Hitches: %llu, last %.2f ms at frame %llu", static_cast<unsigned long long>(hitches), lastHitchMs,
+                static_cast<unsigned long long>(lastHitchFrame));
+
+    const auto& scopes = HProfiler::global().getScopes();
+    scopeOrder.resize(scopes.size());
+    for(size_t i = 0; i < scopes.size(); i++)
+        scopeOrder[i] = i;
+    size_t shown = std::min(scopeOrder.size(), TOP_SCOPES);
+    std::partial_sort(scopeOrder.begin(), scopeOrder.begin() + shown, scopeOrder.end(), [&scopes](size_t a, size_t b)
+    { return scopes[a].lastMs > scopes[b].lastMs; });
+
+    if(ImGui::BeginTable("Scopes", 4, ImGuiTableFlags_SizingFixedFit))
+    {
+        ImGui::TableSetupColumn("CPU scope", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Last ms");
+        ImGui::TableSetupColumn("Avg ms");
+        ImGui::TableSetupColumn("Max ms");
+        ImGui::TableHeadersRow();
+        for(size_t i = 0; i < shown; i++)
+        {
+            const auto& scope = scopes[scopeOrder[i]];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(scope.name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", scope.lastMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", scope.averageMs());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", scope.maxMs);
+        }
+        ImGui::EndTable();
+    }
+
+    if(!gpuQueries.getPasses().empty() && ImGui::BeginTable("Passes", 4, ImGuiTableFlags_SizingFixedFit))
+    {
+        ImGui::TableSetupColumn("GPU pass", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Last ms");
+        ImGui::TableSetupColumn("Avg ms");
+        ImGui::TableSetupColumn("Max ms");
+        ImGui::TableHeadersRow();
+        for(const auto& pass: gpuQueries.getPasses())
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(pass.name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", pass.lastMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", pass.averageMs());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", pass.maxMs);
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+void Hellion::HPerfOverlay::report()
+{
+    if(!HProfiler::enabled())
+        return;
+    update();
+    for(bool gpu: {false, true})
+    {
+        auto stats = computeStats(gpu);
+        if(stats.samples > 0)
+            fmt::println("{} frame times over the last {} frames: avg {:.2f} ms  p50 {:.2f} ms  p95 {:.2f} ms  p99 {:.2f} ms  max {:.2f} ms",
+                         gpu ? "GPU" : "CPU", stats.samples, stats.averageMs, stats.p50Ms, stats.p95Ms, stats.p99Ms, stats.maxMs);
+    }
+    fmt::println("hitches: {} over {} frames", hitches, HProfiler::global().getFrame());
+
+    const auto& scopes = HProfiler::global().getScopes();
+    scopeOrder.resize(scopes.size());
+    for(size_t i = 0; i < scopes.size(); i++)
+        scopeOrder[i] = i;
+    size_t shown = std::min(scopeOrder.size(), TOP_SCOPES);
+    std::partial_sort(scopeOrder.begin(), scopeOrder.begin() + shown, scopeOrder.end(), [&scopes](size_t a, size_t b)
+    { return scopes[a].totalMs > scopes[b].totalMs; });
+    fmt::println("busiest scopes:");
+    for(size_t i = 0; i < shown; i++)
+    {
+        const auto& scope = scopes[scopeOrder[i]];
+        fmt::println("  {}: avg {:.3f} ms, max {:.3f} ms, {} calls", scope.name, scope.averageMs(), scope.maxMs, scope.calls);
+    }
+}
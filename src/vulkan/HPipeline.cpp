@@ -103,3 +103,24 @@ void Hellion::HPipeline::createGraphicsPipeline3(Hellion::PipeConf conf)
     device.getDevice().destroy(geomShaderModule);
     device.getDevice().destroy(fragShaderModule);
 }
+
+void Hellion::HPipeline::createComputePipeline(vk::PipelineLayout layout)
+{
+    auto compShaderModule = shaderLayout[0].createShaderModule(device.getDevice());
+
+    vk::ComputePipelineCreateInfo pipelineInfo = {};
+    pipelineInfo.stage = HPipelineHelper::shaderStage(compShaderModule, vk::ShaderStageFlagBits::eCompute);
+    pipelineInfo.layout = layout;
+    pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+    pipelineInfo.basePipelineIndex = -1;
+    try
+    {
+        pipeline = device.getDevice().createComputePipeline(nullptr, pipelineInfo).value;
+    }
+    catch (vk::SystemError err)
+    {
+        throw std::runtime_error("failed to create compute pipeline!");
+    }
+
+    device.getDevice().destroy(compShaderModule);
+}
@@ -23,4 +23,21 @@ void Hellion::HRenderer::createCommandBuffers()
                                           p1, p2)
         vkTracyContext.emplace_back(c);
     }
+
+    allocInfo.commandPool = device.getComputeCommandPool();
+    computeCommandBuffers = device.getDevice().allocateCommandBuffers(allocInfo);
+
+    // a separate tracy context per queue puts compute and graphics zones on their own timelines, so the overlap is visible
+    for(auto& buff: computeCommandBuffers)
+    {
+        auto p1 = device.getDldi().vkGetPhysicalDeviceCalibrateableTimeDomainsEXT;
+        auto p2 = device.getDldi().vkGetCalibratedTimestampsEXT;
+        auto c = TracyVkContextCalibrated(device.getPhysicalDevice(), device.getDevice(), device.getComputeQueue(), buff,
+                                          p1, p2)
+        vkTracyComputeContext.emplace_back(c);
+    }
+
+    computeTimeline = device.createTimelineSemaphore();
+    graphicsTimeline = device.createTimelineSemaphore();
+    gpuQueries.init(device);
 }
@@ -0,0 +1,53 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/vulkan/HSamplerCache.h"
+#include "../../include/core/HHash.h"
+#include <cassert>
+#include <cstring>
+#include <span>
+
+namespace
+{
+    // every member after pNext is plain data without padding, so the key is the raw tail of the struct
+    std::span<const std::byte> keyBytes(const vk::SamplerCreateInfo& info)
+    {
+        auto begin = reinterpret_cast<const std::byte*>(&info.flags);
+        auto end = reinterpret_cast<const std::byte*>(&info) + sizeof(info);
+        return {begin, static_cast<size_t>(end - begin)};
+    }
+}
+
+size_t Hellion::HSamplerCache::Hash::operator()(const vk::SamplerCreateInfo& info) const
+{
+    auto key = keyBytes(info);
+    return static_cast<size_t>(fnv1a(key.data(), key.size()));
+}
+
+bool Hellion::HSamplerCache::Equal::operator()(const vk::SamplerCreateInfo& a, const vk::SamplerCreateInfo& b) const
+{
+    auto keyA = keyBytes(a);
+    auto keyB = keyBytes(b);
+    return std::memcmp(keyA.data(), keyB.data(), keyA.size()) == 0;
+}
+
+vk::Sampler Hellion::HSamplerCache::get(vk::Device device, const vk::SamplerCreateInfo& info)
+{
+    assert(info.pNext == nullptr && "Chained sampler create infos can't be cached");
+    std::lock_guard lock(mutex);
+    auto it = samplers.find(info);
+    if(it != samplers.end())
+        return it->second;
+    auto sampler = device.createSampler(info);
+    samplers.emplace(info, sampler);
+    return sampler;
+}
+
+void Hellion::HSamplerCache::destroy(vk::Device device)
+{
+    std::lock_guard lock(mutex);
+    for(auto& [info, sampler]: samplers)
+        device.destroy(sampler);
+    samplers.clear();
+}
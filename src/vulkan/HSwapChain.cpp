@@ -4,37 +4,57 @@
 
 #include "../../include/vulkan/HSwapChain.h"
 
-vk::Result Hellion::HSwapChain::submitCommandBuffers(const vk::CommandBuffer& commandBuffers, uint32_t imageIndex)
+vk::Result Hellion::HSwapChain::submitCommandBuffers(const vk::CommandBuffer& commandBuffers, uint32_t imageIndex, std::optional<HTimelinePoint> wait,
+                                                     std::optional<HTimelinePoint> signal)
 {
     HELLION_ZONE_PROFILING()
     vk::SubmitInfo submitInfo = {};
 
-    vk::Semaphore waitSemaphores[] = {imageAvailableSemaphores[currentFrame]};
-    vk::PipelineStageFlags waitStages[] = {vk::PipelineStageFlagBits::eColorAttachmentOutput};
-    submitInfo.waitSemaphoreCount = 1;
+    // binary semaphores ignore their entry in the timeline value arrays
+    vk::Semaphore waitSemaphores[] = {imageAvailableSemaphores[currentFrame], wait ? wait->semaphore : nullptr};
+    vk::PipelineStageFlags waitStages[] = {vk::PipelineStageFlagBits::eColorAttachmentOutput, wait ? wait->stage : vk::PipelineStageFlags{}};
+    uint64_t waitValues[] = {0, wait ? wait->value : 0};
+    submitInfo.waitSemaphoreCount = wait ? 2 : 1;
     submitInfo.pWaitSemaphores = waitSemaphores;
     submitInfo.pWaitDstStageMask = waitStages;
 
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &commandBuffers;
 
-    vk::Semaphore signalSemaphores[] = {renderFinishedSemaphores[currentFrame]};
-    submitInfo.signalSemaphoreCount = 1;
+    vk::Semaphore signalSemaphores[] = {renderFinishedSemaphores[currentFrame], signal ? signal->semaphore : nullptr};
+    uint64_t signalValues[] = {0, signal ? signal->value : 0};
+    submitInfo.signalSemaphoreCount = signal ? 2 : 1;
     submitInfo.pSignalSemaphores = signalSemaphores;
 
+    vk::TimelineSemaphoreSubmitInfo timelineInfo{};
+    timelineInfo.waitSemaphoreValueCount = submitInfo.waitSemaphoreCount;
+    timelineInfo.pWaitSemaphoreValues = waitValues;
+    timelineInfo.signalSemaphoreValueCount = submitInfo.signalSemaphoreCount;
+    timelineInfo.pSignalSemaphoreValues = signalValues;
+    if(wait || signal)
+        submitInfo.pNext = &timelineInfo;
+
     device.getDevice().resetFences(1, &inFlightFences[currentFrame]);
 
     device.getGraphicsQueue().submit(submitInfo, inFlightFences[currentFrame]);
 
     vk::PresentInfoKHR presentInfo = {};
     presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signalSemaphores;
+    presentInfo.pWaitSemaphores = &renderFinishedSemaphores[currentFrame];
 
     vk::SwapchainKHR swapChains[] = {swapChain};
     presentInfo.swapchainCount = 1;
     presentInfo.pSwapchains = swapChains;
     presentInfo.pImageIndices = &imageIndex;
 
+    uint64_t nextPresentId = presentId + 1;
+    vk::PresentIdKHR presentIdInfo{1, &nextPresentId};
+    if(device.supportsPresentWait())
+    {
+        presentInfo.pNext = &presentIdInfo;
+        presentId = nextPresentId;
+    }
+
     vk::Result resultPresent;
     try
     {
@@ -66,17 +86,39 @@ vk::SurfaceFormatKHR Hellion::HSwapChain::chooseSwapSurfaceFormat(const std::vec
 
 vk::PresentModeKHR Hellion::HSwapChain::chooseSwapPresentMode(const std::vector<vk::PresentModeKHR>& availablePresentModes)
 {
-    vk::PresentModeKHR bestMode = vk::PresentModeKHR::eFifo;
+    vk::PresentModeKHR requested;
+    switch(presentPolicy)
+    {
+        case HPresentPolicy::Fifo:
+            requested = vk::PresentModeKHR::eFifo;
+            break;
+        case HPresentPolicy::FifoRelaxed:
+            requested = vk::PresentModeKHR::eFifoRelaxed;
+            break;
+        case HPresentPolicy::Mailbox:
+            requested = vk::PresentModeKHR::eMailbox;
+            break;
+        case HPresentPolicy::Immediate:
+            requested = vk::PresentModeKHR::eImmediate;
+            break;
+    }
 
     for(const auto& availablePresentMode: availablePresentModes)
-    {
-        if(availablePresentMode == vk::PresentModeKHR::eMailbox)
+        if(availablePresentMode == requested)
             return availablePresentMode;
-        else if(availablePresentMode == vk::PresentModeKHR::eImmediate)
-            bestMode = availablePresentMode;
-    }
 
-    return bestMode;
+    // FIFO is the only mode the spec guarantees
+    fmt::println("present mode {} is not supported, falling back to FIFO", vk::to_string(requested));
+    return vk::PresentModeKHR::eFifo;
+}
+
+bool Hellion::HSwapChain::waitForPresent(uint64_t id, uint64_t timeout)
+{
+    if(!device.supportsPresentWait() || id == 0)
+        return false;
+
+    auto result = static_cast<vk::Result>(device.getDldi().vkWaitForPresentKHR(device.getDevice(), swapChain, id, timeout));
+    return result == vk::Result::eSuccess;
 }
 
 vk::Extent2D Hellion::HSwapChain::chooseSwapExtent(const vk::SurfaceCapabilitiesKHR& capabilities)
@@ -104,7 +146,7 @@ void Hellion::HSwapChain::createSwapChain()
     SwapChainSupportDetails swapChainSupport = device.getSwapChainSupport();
 
     vk::SurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
-    vk::PresentModeKHR presentMode = chooseSwapPresentMode(swapChainSupport.presentModes);
+    presentMode = chooseSwapPresentMode(swapChainSupport.presentModes);
     vk::Extent2D extent = chooseSwapExtent(swapChainSupport.capabilities);
 
     uint32_t imageCount = swapChainSupport.capabilities.minImageCount + 1;
@@ -259,11 +301,13 @@ void Hellion::HSwapChain::createDepthResources()
     depthImageAllocs.resize(imageCount());
     depthImageViews.resize(imageCount());
 
+    // depth is cleared on load and never stored, so tile based GPUs can keep it in lazily allocated memory
     for(int i = 0; i < depthImages.size(); i++)
     {
         auto [_depthImage, _depthImageAlloc] = device.createImage(swapChainExtent.width, swapChainExtent.height, 1, depthFormat,
                                                                   vk::ImageTiling::eOptimal,
-                                                                  vk::ImageUsageFlagBits::eDepthStencilAttachment, vk::ImageCreateFlags{}, 1);
+                                                                  vk::ImageUsageFlagBits::eDepthStencilAttachment |
+                                                                  vk::ImageUsageFlagBits::eTransientAttachment, vk::ImageCreateFlags{}, 1);
         depthImages[i] = _depthImage;
         depthImageAllocs[i] = _depthImageAlloc;
         depthImageViews[i] = device.createImageView(depthImages[i], depthFormat, vk::ImageAspectFlagBits::eDepth, 1, vk::ImageViewType::e2D);
@@ -349,10 +393,32 @@ void Hellion::HSwapChain::init()
 {
     createSwapChain();
     createImageViews();
-    createRenderPass();
-    createDepthResources();
-    createFramebuffers();
-    createSyncObjects();
+    if(oldSwapChain != nullptr && oldSwapChain->swapChainImageFormat == swapChainImageFormat)
+    {
+        adoptFromOldSwapChain();
+        createDepthResources();
+        createFramebuffers();
+    } else
+    {
+        createRenderPass();
+        createDepthResources();
+        createFramebuffers();
+        createSyncObjects();
+    }
+}
+
+void Hellion::HSwapChain::adoptFromOldSwapChain()
+{
+    renderPass = oldSwapChain->renderPass;
+    oldSwapChain->renderPass = nullptr;
+
+    imageAvailableSemaphores = std::move(oldSwapChain->imageAvailableSemaphores);
+    renderFinishedSemaphores = std::move(oldSwapChain->renderFinishedSemaphores);
+    inFlightFences = std::move(oldSwapChain->inFlightFences);
+    oldSwapChain->imageAvailableSemaphores.clear();
+    oldSwapChain->renderFinishedSemaphores.clear();
+    oldSwapChain->inFlightFences.clear();
+    currentFrame = oldSwapChain->currentFrame;
 }
 
 void Hellion::HSwapChain::cleanup()
@@ -370,19 +436,26 @@ void Hellion::HSwapChain::cleanup()
 
     for(int i = 0; i < depthImages.size(); i++)
     {
-        vmaDestroyImage(device.getAllocator(), depthImages[i], depthImageAllocs[i]);
+        if(device.getDefragmenter().release(depthImageAllocs[i]))
+        {
+            device.releaseAllocation(depthImageAllocs[i]);
+            device.getDevice().destroyImage(depthImages[i]);
+        } else
+            device.destroyImage(depthImages[i], depthImageAllocs[i]);
         device.getDevice().destroy(depthImageViews[i]);
     }
 
     for(auto framebuffer: swapChainFramebuffers)
         device.getDevice().destroyFramebuffer(framebuffer);
 
-    device.getDevice().destroy(renderPass);
+    if(renderPass)
+        device.getDevice().destroy(renderPass);
 }
 
 void Hellion::HSwapChain::cleanupSyncObjects()
 {
-    for(size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+    // empty when the sync objects were handed over to a newer swapchain
+    for(size_t i = 0; i < inFlightFences.size(); i++)
     {
         device.getDevice().destroySemaphore(renderFinishedSemaphores[i]);
         device.getDevice().destroySemaphore(imageAvailableSemaphores[i]);
@@ -4,12 +4,28 @@
 
 #include "../../include/vulkan/HTexture.h"
 
+#include "../../include/texture/HTextureCache.h"
+#include "../../include/texture/HKtx2.h"
+#include <algorithm>
+#include <array>
+
 #define STB_IMAGE_IMPLEMENTATION
 
 #include <stb_image.h>
 
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+
+#include <stb_image_resize.h>
+
 void Hellion::HTexture::createTextureImage(const std::string& filepath)
 {
+    HELLION_ZONE_PROFILING()
+    if(HKtx2Texture::isKtx2(filepath))
+    {
+        createKtx2TextureImage(filepath);
+        return;
+    }
+
     int texWidth, texHeight, texChannels;
 
     stbi_uc* pixels =
@@ -21,55 +37,281 @@ void Hellion::HTexture::createTextureImage(const std::string& filepath)
         throw std::runtime_error("failed to load texture image!");
     }
 
-    // mMipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(texWidth, texHeight)))) + 1;
-    mipLevels = 1;
+    format = vk::Format::eR8G8B8A8Srgb;
+    extent = vk::Extent3D{static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight), 1};
+    mipLevels = mipLevelCount(extent.width, extent.height);
+    // the blit path only needs level 0 in the staging buffer, the CPU path uploads the whole chain
+    bool blitMips = device.supportsLinearBlit(format);
+
+    std::vector<vk::BufferImageCopy> regions;
+    vk::DeviceSize stagingSize = 0;
+    for(uint32_t level = 0; level < (blitMips ? 1 : mipLevels); level++)
+    {
+        vk::BufferImageCopy region{};
+        region.bufferOffset = stagingSize;
+        region.imageSubresource = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, level, 0, 1};
+        region.imageExtent = vk::Extent3D{std::max(extent.width >> level, 1u), std::max(extent.height >> level, 1u), 1};
+        regions.push_back(region);
+        stagingSize += static_cast<vk::DeviceSize>(region.imageExtent.width) * region.imageExtent.height * 4;
+    }
 
-    HBuffer stagingBuffer(device, imageSize, vk::BufferUsageFlagBits::eTransferSrc, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
-                                                                                    VMA_ALLOCATION_CREATE_MAPPED_BIT);
+    HBuffer stagingBuffer(device, stagingSize, vk::BufferUsageFlagBits::eTransferSrc, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                                                                                      VMA_ALLOCATION_CREATE_MAPPED_BIT);
 
-    memcpy(stagingBuffer.getMappedMemory(), pixels, (size_t) imageSize);
+    auto staging = static_cast<stbi_uc*>(stagingBuffer.getMappedMemory());
+    if(blitMips)
+        memcpy(staging, pixels, (size_t) imageSize);
+    else
+    {
+        auto mips = HTextureCompressor::generateMipChain(pixels, extent.width, extent.height, true);
+        for(size_t i = 0; i < regions.size(); i++)
+            memcpy(staging + regions[i].bufferOffset, mips[i].data(), mips[i].size());
+    }
     stbi_image_free(pixels);
 
+    createImage(vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled);
 
-    format = vk::Format::eR8G8B8A8Srgb;
-    extent = vk::Extent3D{static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight), 1};
+    device.transitionImageLayout(
+            textureImage,
+            format,
+            vk::ImageLayout::eUndefined,
+            vk::ImageLayout::eTransferDstOptimal,
+            mipLevels,
+            layerCount);
+    device.copyBufferToImage(stagingBuffer.getBuffer(), textureImage, regions);
+
+    if(blitMips)
+        device.generateMipmaps(textureImage, format, texWidth, texHeight, mipLevels);
+    else
+        device.transitionImageLayout(
+                textureImage,
+                format,
+                vk::ImageLayout::eTransferDstOptimal,
+                vk::ImageLayout::eShaderReadOnlyOptimal,
+                mipLevels,
+                layerCount);
+
+    textureLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+    fmt::println("texture {} {}x{}, {} mip levels generated on the {}", filepath, texWidth, texHeight, mipLevels, blitMips ? "GPU" : "CPU");
+}
+
+void Hellion::HTexture::createCompressedTextureImage(const std::string& filepath, HTextureCodec codec)
+{
+    HELLION_ZONE_PROFILING()
+    auto texture = HTextureCache::loadOrCompress(filepath, codec);
+    auto& header = texture.header();
+
+    format = HTextureCompressor::vulkanFormat(codec);
+    extent = vk::Extent3D{header.width, header.height, 1};
+    mipLevels = header.levelCount;
+
+    // the cache holds the levels exactly as the image expects them, one copy uploads the whole chain
+    std::vector<vk::BufferImageCopy> regions;
+    uint32_t level = 0;
+    for(const auto& info: texture.levels())
+    {
+        vk::BufferImageCopy region{};
+        region.bufferOffset = info.offset;
+        region.imageSubresource = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, level++, 0, 1};
+        region.imageExtent = vk::Extent3D{info.width, info.height, 1};
+        regions.push_back(region);
+    }
+
+    uploadLevels(texture.data(), regions, false);
+}
+
+void Hellion::HTexture::createKtx2TextureImage(const std::string& filepath)
+{
+    HELLION_ZONE_PROFILING()
+    HKtx2Texture texture(filepath);
+    if(!device.supportsSampledFormat(texture.getFormat()))
+        throw std::runtime_error("failed to load ktx2 texture, format is not supported by the device!");
+
+    format = texture.getFormat();
+    extent = vk::Extent3D{texture.getWidth(), texture.getHeight(), 1};
+    bool blitMips = texture.needsMipGeneration() && device.supportsLinearBlit(format);
+    mipLevels = blitMips ? mipLevelCount(extent.width, extent.height) : static_cast<uint32_t>(texture.getLevels().size());
+
+    // levels are stored smallest first, the staging buffer takes the span that covers all of them
+    auto& levels = texture.getLevels();
+    uint64_t begin = levels.front().offset;
+    uint64_t end = 0;
+    for(const auto& level: levels)
+    {
+        begin = std::min(begin, level.offset);
+        end = std::max(end, level.offset + level.size);
+    }
+
+    std::vector<vk::BufferImageCopy> regions;
+    for(uint32_t level = 0; level < levels.size(); level++)
+    {
+        vk::BufferImageCopy region{};
+        region.bufferOffset = levels[level].offset - begin;
+        region.imageSubresource = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, level, 0, 1};
+        region.imageExtent = vk::Extent3D{levels[level].width, levels[level].height, 1};
+        regions.push_back(region);
+    }
+
+    uploadLevels(texture.bytes().subspan(begin, end - begin), regions, blitMips);
+    fmt::println("texture {} {}x{}, {} mip levels from ktx2", filepath, extent.width, extent.height, mipLevels);
+}
+
+void Hellion::HTexture::uploadLevels(std::span<const std::byte> data, std::span<const vk::BufferImageCopy> regions, bool blitMips)
+{
+    HELLION_ZONE_PROFILING()
+    HBuffer stagingBuffer(device, data.size(), vk::BufferUsageFlagBits::eTransferSrc, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                                                                                      VMA_ALLOCATION_CREATE_MAPPED_BIT);
+    memcpy(stagingBuffer.getMappedMemory(), data.data(), data.size());
+
+    vk::ImageUsageFlags usage = vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled;
+    if(blitMips)
+        usage |= vk::ImageUsageFlagBits::eTransferSrc;
+    createImage(usage);
+
+    device.transitionImageLayout(textureImage, format, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, mipLevels, layerCount);
+    device.copyBufferToImage(stagingBuffer.getBuffer(), textureImage, regions);
+    if(blitMips)
+        device.generateMipmaps(textureImage, format, extent.width, extent.height, mipLevels);
+    else
+        device.transitionImageLayout(textureImage, format, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal,
+                                     mipLevels, layerCount);
+
+    textureLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+}
+
+Hellion::HTexture::HTexture(HDevice& device, vk::Format format, vk::Extent3D extent, uint32_t mipLevels, vk::CommandBuffer commandBuffer,
+                            vk::Buffer stagingBuffer, std::span<const vk::BufferImageCopy> regions)
+        : device{device}, format{format}, mipLevels{mipLevels}, extent{extent}
+{
+    HELLION_ZONE_PROFILING()
+    createImage(vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled);
+
+    device.transitionImageLayout(commandBuffer, textureImage, format, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, mipLevels,
+                                 layerCount);
+    commandBuffer.copyBufferToImage(stagingBuffer, textureImage, vk::ImageLayout::eTransferDstOptimal, static_cast<uint32_t>(regions.size()),
+                                    regions.data());
+    device.transitionImageLayout(commandBuffer, textureImage, format, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal,
+                                 mipLevels, layerCount);
+    textureLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+
+    createTextureImageView(vk::ImageViewType::e2D);
+    createTextureSampler();
+    updateDescriptor();
+}
 
+vk::ImageCreateInfo Hellion::HTexture::imageCreateInfo() const
+{
     vk::ImageCreateInfo imageInfo{};
     imageInfo.imageType = vk::ImageType::e2D;
     imageInfo.extent = extent;
-    imageInfo.mipLevels = 1;
-    imageInfo.arrayLayers = 1;
+    imageInfo.mipLevels = mipLevels;
+    imageInfo.arrayLayers = layerCount;
     imageInfo.format = format;
     imageInfo.tiling = vk::ImageTiling::eOptimal;
     imageInfo.initialLayout = vk::ImageLayout::eUndefined;
-    imageInfo.usage = vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled;
+    imageInfo.usage = imageUsage;
     imageInfo.samples = vk::SampleCountFlagBits::e1;
     imageInfo.sharingMode = vk::SharingMode::eExclusive;
+    return imageInfo;
+}
 
+void Hellion::HTexture::createImage(vk::ImageUsageFlags usage)
+{
+    // the defragmenter copies the image to its new place
+    imageUsage = usage | vk::ImageUsageFlagBits::eTransferSrc;
+    auto imageInfo = imageCreateInfo();
     auto [img, imgAlloc] = device.createImageWithInfo(imageInfo);
     textureImage = img;
     imageAllocation = imgAlloc;
+    device.getDefragmenter().track(imageAllocation, this);
+}
 
-    device.transitionImageLayout(
-            textureImage,
-            vk::Format::eR8G8B8A8Srgb,
-            vk::ImageLayout::eUndefined,
-            vk::ImageLayout::eTransferDstOptimal,
-            mipLevels,
-            layerCount);
-    device.copyBufferToImage(
-            stagingBuffer.getBuffer(),
-            textureImage,
-            static_cast<uint32_t>(texWidth),
-            static_cast<uint32_t>(texHeight));
+void Hellion::HTexture::recordMove(vk::CommandBuffer commandBuffer, VmaAllocation allocation)
+{
+    HELLION_ZONE_PROFILING()
+    auto imageInfo = imageCreateInfo();
+    vk::Image image = device.getDevice().createImage(imageInfo);
+    if(vmaBindImageMemory(device.getAllocator(), allocation, image) != VK_SUCCESS)
+        throw std::runtime_error("failed to bind moved texture memory!");
 
-    device.transitionImageLayout(
-            textureImage,
-            vk::Format::eR8G8B8A8Srgb,
-            vk::ImageLayout::eTransferDstOptimal,
-            vk::ImageLayout::eShaderReadOnlyOptimal,
-            mipLevels,
-            layerCount);
+    vk::ImageSubresourceRange range{vk::ImageAspectFlagBits::eColor, 0, mipLevels, 0, layerCount};
+    std::array<vk::ImageMemoryBarrier, 2> before{};
+    before[0].srcAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eTransferWrite;
+    before[0].dstAccessMask = vk::AccessFlagBits::eTransferRead;
+    before[0].oldLayout = textureLayout;
+    before[0].newLayout = vk::ImageLayout::eTransferSrcOptimal;
+    before[0].image = textureImage;
+    before[0].subresourceRange = range;
+    before[1].dstAccessMask = vk::AccessFlagBits::eTransferWrite;
+    before[1].oldLayout = vk::ImageLayout::eUndefined;
+    before[1].newLayout = vk::ImageLayout::eTransferDstOptimal;
+    before[1].image = image;
+    before[1].subresourceRange = range;
+    for(auto& barrier: before)
+        barrier.srcQueueFamilyIndex = barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    // earlier frames may still sample the old image
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, before);
 
-    textureLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+    std::vector<vk::ImageCopy> copies;
+    for(uint32_t level = 0; level < mipLevels; level++)
+    {
+        vk::ImageCopy copy{};
+        copy.srcSubresource = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, level, 0, layerCount};
+        copy.dstSubresource = copy.srcSubresource;
+        copy.extent = vk::Extent3D{std::max(extent.width >> level, 1u), std::max(extent.height >> level, 1u), 1};
+        copies.push_back(copy);
+    }
+    commandBuffer.copyImage(textureImage, vk::ImageLayout::eTransferSrcOptimal, image, vk::ImageLayout::eTransferDstOptimal, copies);
+
+    vk::ImageMemoryBarrier after{};
+    after.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+    after.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+    after.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+    after.newLayout = textureLayout;
+    after.srcQueueFamilyIndex = after.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    after.image = image;
+    after.subresourceRange = range;
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eAllCommands, {}, {}, {}, after);
+
+    movedImage = textureImage;
+    movedImageView = textureImageView;
+    textureImage = image;
+    createTextureImageView(vk::ImageViewType::e2D);
+    updateDescriptor();
+    revision = nextRevision++;
+}
+
+void Hellion::HTexture::finishMove()
+{
+    device.getDevice().destroy(movedImageView);
+    device.getDevice().destroyImage(movedImage);
+    movedImageView = nullptr;
+    movedImage = nullptr;
+}
+
+Hellion::HTexture::HTexture(HDevice& device, const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t mipLevels) : device{device}
+{
+    HELLION_ZONE_PROFILING()
+    format = vk::Format::eR8G8B8A8Srgb;
+    extent = vk::Extent3D{width, height, 1};
+    this->mipLevels = std::min(mipLevels, mipLevelCount(width, height));
+
+    auto mips = HTextureCompressor::generateMipChain(rgba, width, height, true);
+    std::vector<std::byte> data;
+    std::vector<vk::BufferImageCopy> regions;
+    for(uint32_t level = 0; level < this->mipLevels; level++)
+    {
+        vk::BufferImageCopy region{};
+        region.bufferOffset = data.size();
+        region.imageSubresource = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, level, 0, 1};
+        region.imageExtent = vk::Extent3D{std::max(width >> level, 1u), std::max(height >> level, 1u), 1};
+        regions.push_back(region);
+        auto bytes = std::as_bytes(std::span(mips[level]));
+        data.insert(data.end(), bytes.begin(), bytes.end());
+    }
+
+    uploadLevels(data, regions, false);
+    createTextureImageView(vk::ImageViewType::e2D);
+    createTextureSampler();
+    updateDescriptor();
 }
@@ -0,0 +1,394 @@
+//
+// Created by NePutin on 10/19/2026.
+//
+
+#include "../../include/vulkan/HTextureStreamer.h"
+#include "../../include/vulkan/HSwapChain.h"
+#include "../../include/vulkan/HMemoryMonitor.h"
+#include "../../include/core/HThreadPool.h"
+#include "../../include/texture/HTextureCache.h"
+#include "../../include/texture/HKtx2.h"
+#include "../../include/core/HAllocationTracker.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <imgui.h>
+#include <stb_image.h>
+
+namespace
+{
+    constexpr vk::DeviceSize STAGING_ALIGNMENT = 16;
+    constexpr float MEGABYTE = 1024.0f * 1024.0f;
+
+    vk::DeviceSize alignUp(vk::DeviceSize value, vk::DeviceSize alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+uint32_t Hellion::HTextureStreamer::Entry::tailMip() const
+{
+    uint32_t mip = 0;
+    while(mip + 1 < levelCount() && std::max(source.levels[mip].width, source.levels[mip].height) > MIN_RESIDENT_SIZE)
+        mip++;
+    return mip;
+}
+
+vk::DeviceSize Hellion::HTextureStreamer::Entry::chainSize(uint32_t firstMip) const
+{
+    vk::DeviceSize size = 0;
+    for(uint32_t mip = firstMip; mip < levelCount(); mip++)
+        size += source.levels[mip].size;
+    return size;
+}
+
+Hellion::HTextureStreamer::HTextureStreamer(HDevice& device, float uploadBudgetMB, float memoryBudgetMB) : device{device}
+{
+    setUploadBudget(uploadBudgetMB);
+    setMemoryBudget(memoryBudgetMB);
+    createPlaceholder();
+}
+
+Hellion::HTextureStreamer::~HTextureStreamer()
+{
+    retireUploads(true);
+    // decode tasks own their inputs, waiting keeps the pool from finishing work nobody will read after the device is gone
+    for(auto& entry: entries)
+        if(entry.decoded.valid())
+            entry.decoded.wait();
+}
+
+Hellion::HTextureHandle Hellion::HTextureStreamer::load(const std::string& path, HTextureCodec codec)
+{
+    HELLION_ZONE_PROFILING()
+    if(codec != HTextureCodec::Rgba8 && !device.supportsSampledFormat(HTextureCompressor::vulkanFormat(codec)))
+    {
+        fmt::println("compressed format is not supported, {} is uploaded uncompressed", path);
+        codec = HTextureCodec::Rgba8;
+    }
+
+    Entry entry;
+    entry.path = path;
+    entry.decoded = HThreadPool::global().submit([path, codec]()
+                                                 { return decode(path, codec); });
+    entries.push_back(std::move(entry));
+    return HTextureHandle{static_cast<uint32_t>(entries.size() - 1)};
+}
+
+void Hellion::HTextureStreamer::requestMip(HTextureHandle handle, uint32_t mip)
+{
+    auto& entry = entries[handle.index];
+    if(entry.lastRequest != frame)
+        entry.requestedMip = mip;
+    else
+        entry.requestedMip = std::min(entry.requestedMip, mip);
+    entry.lastRequest = frame;
+}
+
+void Hellion::HTextureStreamer::requestScreenSize(HTextureHandle handle, float screenPixels)
+{
+    const auto& entry = entries[handle.index];
+    if(entry.state != State::Streaming)
+        return;
+    float size = static_cast<float>(std::max(entry.source.levels[0].width, entry.source.levels[0].height));
+    float mip = std::floor(std::log2(size / std::max(screenPixels, 1.0f)));
+    requestMip(handle, static_cast<uint32_t>(std::max(mip, 0.0f)));
+}
+
+void Hellion::HTextureStreamer::update(std::pmr::memory_resource& frameMemory)
+{
+    HELLION_ZONE_PROFILING()
+    HELLION_ALLOCATION_SCOPE("HTextureStreamer::update")
+    frame++;
+    retireUploads(false);
+    // no frame in flight can sample an image replaced more than MAX_FRAMES_IN_FLIGHT updates ago
+    std::erase_if(retired, [&](const RetiredTexture& texture)
+    { return frame - texture.frame > static_cast<uint64_t>(HSwapChain::MAX_FRAMES_IN_FLIGHT); });
+    collectDecoded();
+    computeTargets();
+    startUploads(frameMemory);
+}
+
+vk::DescriptorImageInfo Hellion::HTextureStreamer::getImageInfo(HTextureHandle handle) const
+{
+    const auto& entry = entries[handle.index];
+    return entry.texture ? entry.texture->getImageInfo() : placeholder->getImageInfo();
+}
+
+void Hellion::HTextureStreamer::drawStatsUi()
+{
+    ImGui::Begin("Texture streaming");
+    float budget = static_cast<float>(memoryBudget) / MEGABYTE;
+    if(ImGui::SliderFloat("Memory budget (MB)", &budget, 16.0f, 8192.0f, "%.0f"))
+        setMemoryBudget(budget);
+    ImGui::Text("Resident %.1f MB, requested %.1f MB, budget %.1f MB", stats.residentBytes / MEGABYTE, stats.requestedBytes / MEGABYTE,
+                stats.budgetBytes / MEGABYTE);
+    ImGui::Text("Levels resident %u, requested %u", stats.residentLevels, stats.requestedLevels);
+    ImGui::Text("Textures %u, pending %u", stats.textureCount, stats.pendingTextures);
+    ImGui::Text("Levels loaded %llu, evicted %llu", static_cast<unsigned long long>(stats.loadedLevels),
+                static_cast<unsigned long long>(stats.evictedLevels));
+    ImGui::End();
+}
+
+Hellion::HTextureStreamer::DecodedTexture Hellion::HTextureStreamer::decode(const std::string& path, HTextureCodec codec)
+{
+    HELLION_ZONE_PROFILING()
+    DecodedTexture decoded;
+    if(HKtx2Texture::isKtx2(path))
+    {
+        HKtx2Texture texture(path);
+        decoded.format = texture.getFormat();
+        for(const auto& info: texture.getLevels())
+        {
+            auto bytes = texture.bytes().subspan(info.offset, info.size);
+            decoded.levels.push_back(HTextureLevel{info.width, info.height, decoded.bytes.size(), info.size});
+            decoded.bytes.insert(decoded.bytes.end(), bytes.begin(), bytes.end());
+            decoded.bytes.resize(alignUp(decoded.bytes.size(), STAGING_ALIGNMENT));
+        }
+        return decoded;
+    }
+
+    if(codec != HTextureCodec::Rgba8)
+    {
+        auto texture = HTextureCache::loadOrCompress(path, codec);
+        decoded.format = HTextureCompressor::vulkanFormat(codec);
+        decoded.levels.assign(texture.levels().begin(), texture.levels().end());
+        auto data = texture.data();
+        decoded.bytes.assign(data.begin(), data.end());
+        return decoded;
+    }
+
+    int width, height, channels;
+    stbi_uc* pixels = stbi_load(path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    if(!pixels)
+        throw std::runtime_error("failed to load texture image!");
+
+    auto mips = HTextureCompressor::generateMipChain(pixels, width, height, true);
+    stbi_image_free(pixels);
+
+    for(uint32_t level = 0; level < mips.size(); level++)
+    {
+        uint32_t levelWidth = std::max(static_cast<uint32_t>(width) >> level, 1u);
+        uint32_t levelHeight = std::max(static_cast<uint32_t>(height) >> level, 1u);
+        decoded.levels.push_back(HTextureLevel{levelWidth, levelHeight, decoded.bytes.size(), mips[level].size()});
+        auto bytes = std::as_bytes(std::span(mips[level]));
+        decoded.bytes.insert(decoded.bytes.end(), bytes.begin(), bytes.end());
+    }
+    return decoded;
+}
+
+void Hellion::HTextureStreamer::createPlaceholder()
+{
+    HELLION_ZONE_PROFILING()
+    const uint8_t white[4] = {255, 255, 255, 255};
+    HBuffer staging(device, sizeof(white), vk::BufferUsageFlagBits::eTransferSrc, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                                                                                  VMA_ALLOCATION_CREATE_MAPPED_BIT);
+    memcpy(staging.getMappedMemory(), white, sizeof(white));
+
+    vk::BufferImageCopy region{};
+    region.imageSubresource = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, 0, 0, 1};
+    region.imageExtent = vk::Extent3D{1, 1, 1};
+    auto commandBuffer = device.beginSingleTimeCommands();
+    placeholder = std::make_unique<HTexture>(device, vk::Format::eR8G8B8A8Srgb, vk::Extent3D{1, 1, 1}, 1, commandBuffer, staging.getBuffer(),
+                                             std::span(&region, 1));
+    device.endSingleTimeCommands(commandBuffer);
+}
+
+void Hellion::HTextureStreamer::retireUploads(bool wait)
+{
+    HELLION_ZONE_PROFILING()
+    auto vkDevice = device.getDevice();
+    std::erase_if(uploads, [&](Upload& upload)
+    {
+        if(wait)
+            (void) vkDevice.waitForFences(upload.fence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+        else if(vkDevice.getFenceStatus(upload.fence) != vk::Result::eSuccess)
+            return false;
+
+        for(auto& pending: upload.textures)
+        {
+            auto& entry = entries[pending.index];
+            if(pending.firstMip < entry.residentMip)
+                stats.loadedLevels += std::min(entry.residentMip, entry.levelCount()) - pending.firstMip;
+            else
+                stats.evictedLevels += pending.firstMip - entry.residentMip;
+            if(entry.texture)
+                retired.push_back(RetiredTexture{frame, std::move(entry.texture)});
+            entry.texture = std::move(pending.texture);
+            entry.residentMip = pending.firstMip;
+            entry.uploading = false;
+        }
+        vkDevice.destroy(upload.fence);
+        vkDevice.freeCommandBuffers(device.getCommandPool(), upload.commandBuffer);
+        return true;
+    });
+}
+
+void Hellion::HTextureStreamer::collectDecoded()
+{
+    HELLION_ZONE_PROFILING()
+    for(auto& entry: entries)
+    {
+        if(entry.state != State::Decoding || entry.decoded.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            continue;
+        try
+        {
+            entry.source = entry.decoded.get();
+            if(entry.source.levels.empty() || !device.supportsSampledFormat(entry.source.format))
+                throw std::runtime_error("failed to load texture, format is not supported by the device!");
+            entry.residentMip = entry.levelCount();
+            entry.state = State::Streaming;
+        }
+        catch(const std::exception& e)
+        {
+            // the handle keeps sampling the placeholder
+            fmt::println("{}: {}", entry.path, e.what());
+            entry.source = {};
+            entry.state = State::Failed;
+        }
+    }
+}
+
+void Hellion::HTextureStreamer::computeTargets()
+{
+    HELLION_ZONE_PROFILING()
+    stats.residentBytes = 0;
+    stats.requestedBytes = 0;
+    stats.residentLevels = 0;
+    stats.requestedLevels = 0;
+    stats.textureCount = 0;
+    stats.pendingTextures = 0;
+
+    vk::DeviceSize targetBytes = 0;
+    for(auto& entry: entries)
+    {
+        if(entry.state == State::Decoding)
+            stats.pendingTextures++;
+        if(entry.state != State::Streaming)
+            continue;
+
+        uint32_t tail = entry.tailMip();
+        bool requested = entry.requestedMip != UINT32_MAX && frame - entry.lastRequest <= REQUEST_TIMEOUT;
+        entry.targetMip = requested ? std::min(entry.requestedMip, tail) : tail;
+
+        stats.textureCount++;
+        stats.residentBytes += entry.chainSize(entry.residentMip);
+        stats.residentLevels += entry.levelCount() - entry.residentMip;
+        stats.requestedBytes += entry.chainSize(entry.targetMip);
+        stats.requestedLevels += entry.levelCount() - entry.targetMip;
+        if(entry.uploading || entry.residentMip != entry.targetMip)
+            stats.pendingTextures++;
+        targetBytes += entry.chainSize(entry.targetMip);
+    }
+
+    // other allocations count against the heap budget too, the textures may only grow into what is left of it below the
+    // memory monitor's warning level, so growing never triggers an eviction request
+    auto heapBudget = device.getDeviceLocalBudget();
+    auto heapLimit = static_cast<vk::DeviceSize>(static_cast<double>(heapBudget.budget) * HMemoryMonitor::WARNING_RATIO);
+    vk::DeviceSize headroom = heapLimit > heapBudget.usage ? heapLimit - heapBudget.usage : 0;
+    stats.budgetBytes = std::min(memoryBudget, stats.residentBytes + headroom);
+    if(pendingEviction > 0)
+        stats.budgetBytes = std::min(stats.budgetBytes, stats.residentBytes - std::min(stats.residentBytes, pendingEviction));
+    pendingEviction = 0;
+
+    // drop the single largest level until the chains fit, large levels buy the most memory for the least visible loss
+    while(targetBytes > stats.budgetBytes)
+    {
+        Entry* largest = nullptr;
+        for(auto& entry: entries)
+            if(entry.state == State::Streaming && entry.targetMip < entry.tailMip() &&
+               (!largest || entry.source.levels[entry.targetMip].size > largest->source.levels[largest->targetMip].size))
+                largest = &entry;
+        if(!largest)
+            break;
+        targetBytes -= largest->source.levels[largest->targetMip].size;
+        largest->targetMip++;
+    }
+}
+
+void Hellion::HTextureStreamer::startUploads(std::pmr::memory_resource& frameMemory)
+{
+    HELLION_ZONE_PROFILING()
+    std::pmr::vector<uint32_t> candidates(&frameMemory);
+    for(uint32_t i = 0; i < entries.size(); i++)
+        if(entries[i].state == State::Streaming && !entries[i].uploading && entries[i].targetMip != entries[i].residentMip)
+            candidates.push_back(i);
+    if(candidates.empty())
+        return;
+
+    // textures still on the placeholder go first, then evictions that free memory, then the largest missing chains
+    auto priority = [&](uint32_t index)
+    {
+        const auto& entry = entries[index];
+        if(!entry.texture)
+            return std::numeric_limits<int64_t>::max();
+        if(entry.targetMip > entry.residentMip)
+            return std::numeric_limits<int64_t>::max() - 1;
+        return static_cast<int64_t>(entry.residentMip - entry.targetMip);
+    };
+    // ties keep the index order, a stable_sort would allocate its buffer on the heap
+    std::sort(candidates.begin(), candidates.end(), [&](uint32_t a, uint32_t b)
+    { return priority(a) > priority(b) || (priority(a) == priority(b) && a < b); });
+
+    // the first texture of a frame always starts, so one larger than the budget is not stuck forever
+    std::pmr::vector<uint32_t> batch(&frameMemory);
+    vk::DeviceSize stagingSize = 0;
+    for(uint32_t index: candidates)
+    {
+        if(stagingSize >= uploadBudget)
+            break;
+        const auto& entry = entries[index];
+        for(uint32_t mip = entry.targetMip; mip < entry.levelCount(); mip++)
+            stagingSize = alignUp(stagingSize, STAGING_ALIGNMENT) + entry.source.levels[mip].size;
+        batch.push_back(index);
+    }
+
+    Upload upload;
+    upload.staging = std::make_unique<HBuffer>(device, stagingSize, vk::BufferUsageFlagBits::eTransferSrc,
+                                               VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT);
+
+    vk::CommandBufferAllocateInfo allocInfo{};
+    allocInfo.level = vk::CommandBufferLevel::ePrimary;
+    allocInfo.commandPool = device.getCommandPool();
+    allocInfo.commandBufferCount = 1;
+    upload.commandBuffer = device.getDevice().allocateCommandBuffers(allocInfo)[0];
+    upload.commandBuffer.begin(vk::CommandBufferBeginInfo{vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+
+    // a residency change always creates a new image holding the chain from targetMip down, filled from the system memory copy
+    auto staging = static_cast<std::byte*>(upload.staging->getMappedMemory());
+    vk::DeviceSize offset = 0;
+    for(uint32_t index: batch)
+    {
+        auto& entry = entries[index];
+        std::pmr::vector<vk::BufferImageCopy> regions(&frameMemory);
+        for(uint32_t mip = entry.targetMip; mip < entry.levelCount(); mip++)
+        {
+            const auto& level = entry.source.levels[mip];
+            offset = alignUp(offset, STAGING_ALIGNMENT);
+            memcpy(staging + offset, entry.source.bytes.data() + level.offset, level.size);
+
+            vk::BufferImageCopy region{};
+            region.bufferOffset = offset;
+            region.imageSubresource = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, mip - entry.targetMip, 0, 1};
+            region.imageExtent = vk::Extent3D{level.width, level.height, 1};
+            regions.push_back(region);
+            offset += level.size;
+        }
+
+        const auto& base = entry.source.levels[entry.targetMip];
+        auto texture = std::make_unique<HTexture>(device, entry.source.format, vk::Extent3D{base.width, base.height, 1},
+                                                  static_cast<uint32_t>(regions.size()), upload.commandBuffer, upload.staging->getBuffer(), regions);
+        upload.textures.push_back(PendingTexture{index, entry.targetMip, std::move(texture)});
+        entry.uploading = true;
+    }
+    upload.commandBuffer.end();
+
+    // submitted without waiting, the fence is polled by the following updates
+    upload.fence = device.getDevice().createFence(vk::FenceCreateInfo{});
+    vk::SubmitInfo submitInfo{};
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &upload.commandBuffer;
+    device.getGraphicsQueue().submit(submitInfo, upload.fence);
+    uploads.push_back(std::move(upload));
+}
@@ -3,22 +3,35 @@
 //
 
 #include "../../include/vulkan/RenderSystem.h"
+#include "../../include/core/HAllocationTracker.h"
 
 void Hellion::RenderSystem::draw(vk::CommandBuffer& buffer, uint32_t currentFrame, tracy::VkCtx* tracyCtx)
 {
     HELLION_ZONE_PROFILING()
+    HELLION_NO_ALLOCATION_SCOPE("RenderSystem::draw")
     HELLION_GPUZONE_PROFILING(tracyCtx, buffer, "RenderSystem draw")
     pipeline->bind(buffer);
 
     buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipelineLayout, 0, 1, &globalDescriptorSets[currentFrame], 0, nullptr);
 
-    vk::Buffer vertexBuffers[] = {vertexBuffer->getBuffer()};
+    geometry.bind(buffer);
 
-    vk::DeviceSize offsets[] = {0};
+    if(useMeshletCulling())
+    {
+        meshletCuller->draw(buffer, currentFrame);
+        return;
+    }
+    const auto& range = geometry.getRange(geometryHandle);
+    const auto& lod = lods[currentLod];
+    buffer.drawIndexed(lod.indexCount, 1, range.firstIndex + lod.indexOffset, range.vertexOffset, 0);
+}
 
-    buffer.bindVertexBuffers(0, 1, vertexBuffers, offsets);
-
-    buffer.bindIndexBuffer(indexBuffer->getBuffer(), 0, vk::IndexType::eUint32);
-
-    buffer.drawIndexed(static_cast<uint32_t>(indices.size()), 1, 0, 0, 0);
+void Hellion::RenderSystem::cull(vk::CommandBuffer computeBuffer, uint32_t currentFrame, tracy::VkCtx* tracyCtx)
+{
+    HELLION_ZONE_PROFILING()
+    HELLION_NO_ALLOCATION_SCOPE("RenderSystem::cull")
+    // coarser LODs are drawn whole, the meshlets only cover LOD 0
+    if(!useMeshletCulling())
+        return;
+    meshletCuller->cull(computeBuffer, currentFrame, geometry.getRange(geometryHandle), cullViewProj, cullModel, cullCameraPosition, tracyCtx);
 }
\ No newline at end of file